@@ -0,0 +1,51 @@
+#include "abdada.hpp"
+
+namespace ABDADA {
+
+namespace {
+
+// 64Kb, a slot holds the position hash with its 24 lower bits replaced by the owner thread id and the depth (0 is an empty slot)
+// layout : hash (40) | owner (16) | depth (8), the slot index is taken from the replaced hash bits
+constexpr size_t   tableSize = 8192;
+constexpr uint64_t infoMask  = 0xFFFFFFull;
+static_assert(MAX_THREADS <= (1ull << 16), "owner thread id does not fit in an ABDADA slot");
+array1d<std::atomic<uint64_t>, tableSize> table {};
+
+[[nodiscard]] FORCE_FINLINE std::atomic<uint64_t>& slot(const Hash h) { return table[(h >> 8) & (tableSize - 1)]; }
+
+[[nodiscard]] FORCE_FINLINE uint64_t key(const Hash h, const DepthType d, const size_t owner) {
+   return (h & ~infoMask) | (static_cast<uint64_t>(owner) << 8) | static_cast<uint8_t>(std::max(d, DepthType(0)));
+}
+
+[[nodiscard]] FORCE_FINLINE size_t ownerOf(const uint64_t v) { return static_cast<size_t>((v & infoMask) >> 8); }
+
+} // namespace
+
+void clear() {
+   for (auto& s : table) s.store(0, std::memory_order_relaxed);
+}
+
+bool isSearched(const Hash h, const DepthType d, const size_t owner) {
+   const uint64_t v = slot(h).load(std::memory_order_relaxed);
+   // a mark of the same thread (for instance a repetition of an ancestor position) is not a concurrent search
+   return v != 0 && (v & ~infoMask) == (h & ~infoMask) && ownerOf(v) != owner && static_cast<DepthType>(v & 0xFF) >= d;
+}
+
+Guard::Guard(const Hash h, const DepthType d, const size_t owner) {
+   if (h == nullHash) return;
+   uint64_t       expected = 0;
+   const uint64_t k        = key(h, d, owner);
+   if (std::atomic<uint64_t>& s = slot(h); s.compare_exchange_strong(expected, k, std::memory_order_relaxed)) {
+      _slot = &s;
+      _key  = k;
+   }
+}
+
+Guard::~Guard() {
+   if (!_slot) return;
+   uint64_t expected = _key;
+   // only our own mark is removed
+   DISCARD _slot->compare_exchange_strong(expected, 0, std::memory_order_relaxed);
+}
+
+} // namespace ABDADA
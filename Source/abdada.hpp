@@ -0,0 +1,31 @@
+#pragma once
+
+#include "definition.hpp"
+
+/*!
+ * ABDADA like "currently searching" table, shared by all search threads (Lazy SMP helpers)
+ * A node marks its position (and depth) while its moves are searched,
+ * at non-PV nodes, a move leading to a position already marked by another thread is tried last.
+ * This is a small lock-free table, a collision only leads to a useless deferral or a missed one.
+ */
+namespace ABDADA {
+
+void clear();
+
+// is this position being searched by another thread than owner at depth d or more
+[[nodiscard]] bool isSearched(Hash h, DepthType d, size_t owner);
+
+// marks the position as being searched by owner while alive (nothing is done for nullHash or if the slot is already used)
+class Guard {
+  public:
+   Guard(Hash h, DepthType d, size_t owner);
+   ~Guard();
+   Guard(const Guard&)            = delete;
+   Guard& operator=(const Guard&) = delete;
+
+  private:
+   std::atomic<uint64_t>* _slot = nullptr; // nullptr if nothing was marked
+   uint64_t               _key  = 0;
+};
+
+} // namespace ABDADA
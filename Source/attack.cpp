@@ -178,6 +178,10 @@ array1d<SMagic,NbSquare> rookMagic;
 array2d<BitBoard,NbSquare,1 << BISHOP_INDEX_BITS> bishopAttacks;
 array2d<BitBoard,NbSquare,1 << ROOK_INDEX_BITS> rookAttacks;
 
+#if defined(WITH_ISA_DISPATCH) && defined(ENV64BIT)
+bool usePext = false;
+#endif
+
 constexpr array1d<BitBoard,NbSquare> bishopMagics = {
     0x1002004102008200, 0x1002004102008200, 0x4310002248214800, 0x402010c110014208, 0xa000a06240114001, 0xa000a06240114001, 0x402010c110014208, 0xa000a06240114001,
     0x1002004102008200, 0x1002004102008200, 0x1002004102008200, 0x1002004102008200, 0x100c009840001000, 0x4310002248214800, 0xa000a06240114001, 0x4310002248214800,
@@ -97,12 +97,26 @@ extern array1d<SMagic, NbSquare> rookMagic;
 extern array2d<BitBoard, NbSquare, 1 << BISHOP_INDEX_BITS> bishopAttacks;
 extern array2d<BitBoard, NbSquare, 1 << ROOK_INDEX_BITS> rookAttacks;
 
-#if defined(__BMI2__) && !defined(__znver1) && !defined(__znver2) && !defined(__bdver4) && defined(ENV64BIT)
+#if defined(WITH_ISA_DISPATCH) && defined(ENV64BIT)
+// PEXT is only used if the running CPU has a fast one (see ISA::init), 
+// the instruction is emitted directly as BMI2 is not part of the build target
+extern bool usePext;
+[[nodiscard]] FORCE_FINLINE uint64_t pext(const BitBoard m, const BitBoard mask) {
+   uint64_t r;
+   __asm__("pextq %2, %1, %0" : "=r"(r) : "r"(m), "r"(mask));
+   return r;
+}
+inline auto MAGICBISHOPINDEX(const BitBoard m, const Square x) { return usePext ? pext(m, MagicBB::bishopMagic[x].mask) : (((m & MagicBB::bishopMagic[x].mask) * MagicBB::bishopMagic[x].magic) >> (NbSquare - BISHOP_INDEX_BITS));}
+inline auto MAGICROOKINDEX(const BitBoard m, const Square x)   { return usePext ? pext(m, MagicBB::rookMagic[x].mask)   : (((m & MagicBB::rookMagic[x].mask)   * MagicBB::rookMagic[x].magic)   >> (NbSquare - ROOK_INDEX_BITS));}
+inline const char* indexMethod() { return usePext ? "pext" : "magic multiply"; }
+#elif defined(__BMI2__) && !defined(__znver1) && !defined(__znver2) && !defined(__bdver4) && defined(ENV64BIT)
 inline auto MAGICBISHOPINDEX(const BitBoard m, const Square x) { return _pext_u64(m, MagicBB::bishopMagic[x].mask);}
 inline auto MAGICROOKINDEX(const BitBoard m, const Square x)    { return _pext_u64(m, MagicBB::rookMagic[x].mask);}
+inline const char* indexMethod() { return "pext"; }
 #else
 inline auto MAGICBISHOPINDEX(const BitBoard m, const Square x) { return static_cast<int>(((m & MagicBB::bishopMagic[x].mask) * MagicBB::bishopMagic[x].magic) >> (NbSquare - BISHOP_INDEX_BITS));}
 inline auto MAGICROOKINDEX(const BitBoard m, const Square x)   { return static_cast<int>(((m & MagicBB::rookMagic[x].mask) * MagicBB::rookMagic[x].magic) >> (NbSquare - ROOK_INDEX_BITS));}
+inline const char* indexMethod() { return "magic multiply"; }
 #endif
 
 inline auto MAGICBISHOPATTACKS(const BitBoard m, const Square x) { return MagicBB::bishopAttacks[x][MAGICBISHOPINDEX(m, x)];}
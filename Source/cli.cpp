@@ -7,6 +7,7 @@
 #include "material.hpp"
 #include "moveApply.hpp"
 #include "moveGen.hpp"
+#include "nnueBatch.hpp"
 #include "option.hpp"
 #include "position.hpp"
 #include "searcher.hpp"
@@ -27,6 +28,9 @@ void selfPlay(DepthType depth, uint64_t & nbPos);
 // see cli_SEETest.cpp
 bool TestSEE();
 
+// see cli_SIMDTest.cpp
+bool TestSIMD(const std::string& fileName);
+
 void analyze(const Position& p, DepthType depth, bool openBenchOutput = false) {
    static double  benchms    = 0;
    static Counter benchNodes = 0;
@@ -66,8 +70,7 @@ void analyze(const Position& p, DepthType depth, bool openBenchOutput = false) {
    if (openBenchOutput) {
       Logging::LogIt(Logging::logInfo) << "Next two lines are for OpenBench";
       const TimeType ms = getTimeDiff(ThreadPool::instance().main().startTime);
-      const Counter nodeCount =
-          ThreadPool::instance().main().stats.counters[Stats::sid_nodes] + ThreadPool::instance().main().stats.counters[Stats::sid_qnodes];
+      const Counter nodeCount = ThreadPool::instance().counter(Stats::sid_nodes) + ThreadPool::instance().counter(Stats::sid_qnodes);
       benchNodes += nodeCount;
       benchms += static_cast<decltype(benchms)>(ms) / 1000.;
       DynamicConfig::minOutputLevel = oldOutLvl;
@@ -327,6 +330,10 @@ bool cliManagement(const std::string & firstArg, int argc, char** argv) {
       return TestSEE();
    }
 
+   if (firstArg == "-simd_test") {
+      return TestSIMD(argc > 2 ? args[2] : "");
+   }
+
    if (firstArg == "bench" || firstArg == "-bench") {
       DepthType d = 16;
       if (argc > 2) d = clampDepth(atoi(args[2]));
@@ -386,10 +393,70 @@ bool cliManagement(const std::string & firstArg, int argc, char** argv) {
       ms = getTimeDiff(startTime);
       Logging::LogIt(Logging::logInfo) << "Eval speed : " << static_cast<double>(data.size()) * loops / (static_cast<double>(ms) * 1000) << " Meval/s";
 
+#ifdef WITH_NNUE
+      if (DynamicConfig::useNNUE) {
+         // net only, one position at a time then batched
+         std::vector<float> scores(data.size());
+         startTime = Clock::now();
+         for (int k = 0; k < loops; ++k)
+            for (size_t i = 0; i < data.size(); ++i) {
+               NNUEEvaluator evaluator;
+               data[i].resetNNUEEvaluator(evaluator);
+               scores[i] = evaluator.propagate(data[i].c, NNUEBatch::bucket(data[i])).evaluation;
+            }
+         ms = getTimeDiff(startTime);
+         Logging::LogIt(Logging::logInfo) << "NNUE speed : " << static_cast<double>(data.size()) * loops / (static_cast<double>(ms) * 1000) << " Meval/s";
+
+         std::vector<float> batchScores(data.size());
+         startTime = Clock::now();
+         for (int k = 0; k < loops; ++k) NNUEBatch::evaluate(data, batchScores, DynamicConfig::threads);
+         ms = getTimeDiff(startTime);
+         Logging::LogIt(Logging::logInfo) << "Batched NNUE speed (" << DynamicConfig::threads << " threads) : " << static_cast<double>(data.size()) * loops / (static_cast<double>(ms) * 1000) << " Meval/s";
+         if (scores != batchScores) Logging::LogIt(Logging::logError) << "Batched NNUE scores differ from single ones";
+      }
+#endif
+
       ThreadPool::instance().displayStats();
       return true;
    }
 
+#if defined(WITH_NNUE) && defined(USE_SIMD_INTRIN)
+   if (firstArg == "-nnueIntAccuracy") {
+      if (!DynamicConfig::useNNUE) {
+         Logging::LogIt(Logging::logError) << "No net loaded (see -NNUEFile)";
+         return false;
+      }
+      std::string filename = "Book_and_Test/TestSuite/evalSpeed.epd";
+      if (argc > 2) filename = args[2];
+      std::vector<std::string> positions;
+      if (!readEPDFile(filename, positions)) return false;
+      Logging::LogIt(Logging::logInfo) << "Comparing integer and float NNUE inference with file " << filename;
+      double sumDiff = 0;
+      double maxDiff = 0;
+      size_t count   = 0;
+      for (const auto& fen : positions) {
+         RootPosition pos(fen, false);
+         NNUEEvaluator evaluator;
+         pos.associateEvaluator(evaluator);
+         pos.resetNNUEEvaluator(evaluator);
+         for (int bucket = 0; bucket < decltype(NNUEEvaluator::weights)::nbuckets; ++bucket) {
+            const double diff = std::fabs(evaluator.propagateFloat(pos.c, bucket).evaluation - evaluator.propagateInt(pos.c, bucket).evaluation);
+            sumDiff += diff;
+            maxDiff = std::max(maxDiff, diff);
+            ++count;
+         }
+      }
+      if (count == 0) {
+         Logging::LogIt(Logging::logError) << "No position read";
+         return false;
+      }
+      Logging::LogIt(Logging::logInfo) << "Positions " << positions.size() << " (" << count << " evaluations)";
+      Logging::LogIt(Logging::logInfo) << "Mean absolute difference " << sumDiff / static_cast<double>(count);
+      Logging::LogIt(Logging::logInfo) << "Max absolute difference  " << maxDiff;
+      return true;
+   }
+#endif
+
    if (firstArg == "-timeTest") {
       TimeMan::TCType tcType      = TimeMan::TC_suddendeath;
       TimeType        initialTime = 50000;
@@ -0,0 +1,160 @@
+#include "definition.hpp"
+#include "dynamicConfig.hpp"
+#include "logging.hpp"
+#include "position.hpp"
+#include "positionTools.hpp"
+
+#if defined(WITH_NNUE) && defined(USE_SIMD_INTRIN)
+
+namespace {
+
+using nnue::firstInnerLayerSize;
+using nnue::Quantization;
+
+// relative tolerance for float reductions (summation order differs between widths)
+constexpr float dotTolerance = 1e-4f;
+
+template<typename T, size_t N>
+[[nodiscard]] bool sameData(const T* a, const T* b) {
+   return std::memcmp(a, b, N * sizeof(T)) == 0;
+}
+
+[[nodiscard]] bool closeEnough(const float a, const float b) {
+   return std::fabs(a - b) <= dotTolerance * std::max(1.f, std::max(std::fabs(a), std::fabs(b)));
+}
+
+// compare the widest kernels against the 256 bits ones, using accumulators and weights of real positions
+template<size_t W>
+[[nodiscard]] int compareKernels(const Position& p, const NNUEEvaluator& evaluator) {
+   constexpr size_t N     = firstInnerLayerSize;
+   constexpr bool   Q     = NNUEWrapper::quantization;
+   const auto&      net   = NNUEEvaluator::weights;
+   int              errors = 0;
+   auto check = [&](const bool ok, const std::string& what) {
+      if (!ok) {
+         Logging::LogIt(Logging::logError) << "SIMD " << W << " bits mismatch (" << what << ") " << GetFEN(p);
+         ++errors;
+      }
+   };
+
+   const int16_t* acc  = evaluator.white.active().data;
+   const int16_t* acc2 = evaluator.black.active().data;
+   const int16_t* row0 = net.w.row(NNUEIndiceUs(p.king[Co_White], p.king[Co_White], P_wk));
+   const int16_t* row1 = net.w.row(NNUEIndiceThem(p.king[Co_White], p.king[Co_Black], P_wk));
+   const int16_t* row2 = net.b.row(NNUEIndiceUs(p.king[Co_Black], p.king[Co_Black], P_wk));
+
+   // accumulator updates, must be exact
+   {
+      alignas(NNUEALIGNMENT) int16_t a[N];
+      alignas(NNUEALIGNMENT) int16_t b[N];
+      simdCopy_i16<N, W>(a, acc);
+      simdCopy_i16<N, 256>(b, acc);
+      check(sameData<int16_t, N>(a, b), "copy");
+      simdAdd_i16<N, W>(a, row0);
+      simdAdd_i16<N, 256>(b, row0);
+      check(sameData<int16_t, N>(a, b), "add");
+      simdSub_i16<N, W>(a, row1);
+      simdSub_i16<N, 256>(b, row1);
+      check(sameData<int16_t, N>(a, b), "sub");
+      simdAddSub_i16<N, 2, 2, W>(a, acc, std::array{row0, row1}, std::array{row2, row1});
+      simdAddSub_i16<N, 2, 2, 256>(b, acc, std::array{row0, row1}, std::array{row2, row1});
+      check(sameData<int16_t, N>(a, b), "add2-sub2");
+   }
+
+   // input dequantization and activation, element wise so must be exact
+   alignas(NNUEALIGNMENT) float x[2 * N];
+   {
+      alignas(NNUEALIGNMENT) float y[2 * N];
+      constexpr float deqScale = 1.f / Quantization<Q>::scale;
+      simdDequantizeActivate_i16_f32<N, Q, W>(x, acc, deqScale);
+      simdDequantizeActivate_i16_f32<N, Q, W>(x + N, acc2, deqScale);
+      simdDequantizeActivate_i16_f32<N, Q, 256>(y, acc, deqScale);
+      simdDequantizeActivate_i16_f32<N, Q, 256>(y + N, acc2, deqScale);
+      check(sameData<float, 2 * N>(x, y), "dequantize activate");
+
+      alignas(NNUEALIGNMENT) float z[2 * N];
+      simdDequantize_i16_f32<N, W>(y, acc, 4 * deqScale);
+      simdDequantize_i16_f32<N, 256>(z, acc, 4 * deqScale);
+      check(sameData<float, N>(y, z), "dequantize");
+      simdActivation<N, Q, W>(y);
+      simdActivation<N, Q, 256>(z);
+      check(sameData<float, N>(y, z), "activation");
+   }
+
+   // inner layers dot products, only the summation order differs
+   for (int bucket = 0; bucket < NNUEEvaluator::weights.nbuckets; ++bucket) {
+      const auto& fc0 = net.innerLayer[bucket].fc0;
+      for (size_t i = 0; i < 8; ++i) {
+         const float a = simdDotProduct<2 * N, Q, W>(x, fc0.W + i * 2 * N);
+         const float b = simdDotProduct<2 * N, Q, 256>(x, fc0.W + i * 2 * N);
+         check(closeEnough(a, b), "fc0 dot product");
+      }
+      const auto& fc3 = net.innerLayer[bucket].fc3;
+      check(closeEnough(simdDotProduct<24, Q, W>(x, fc3.W), simdDotProduct<24, Q, 256>(x, fc3.W)), "fc3 dot product");
+   }
+
+   // integer path, must be exact
+   {
+      alignas(NNUEALIGNMENT) uint8_t a[N];
+      alignas(NNUEALIGNMENT) uint8_t b[N];
+      simdActivateU8_i16<N, W>(a, acc);
+      simdActivateU8_i16<N, 256>(b, acc);
+      check(sameData<uint8_t, N>(a, b), "uint8 activation");
+      for (int bucket = 0; bucket < NNUEEvaluator::weights.nbuckets; ++bucket) {
+         const int8_t* w = net.fc0Int[bucket].W;
+         // only first half of the input is used here, this is enough to compare kernels
+         check(simdDotProduct_u8i8<N, W>(a, w) == simdDotProduct_u8i8<N, 256>(a, w), "uint8 dot product");
+      }
+   }
+   return errors;
+}
+
+} // namespace
+
+bool TestSIMD(const std::string& fileName) {
+   if constexpr (V_SIMD_MAX <= 256) {
+      Logging::LogIt(Logging::logInfo) << "Nothing to compare, this build has no SIMD path wider than 256 bits";
+      return true;
+   }
+   else {
+      if (!DynamicConfig::useNNUE) {
+         Logging::LogIt(Logging::logError) << "No net loaded (see -NNUEFile)";
+         return false;
+      }
+      std::vector<std::string> positions;
+      if (!fileName.empty()) {
+         if (!readEPDFile(fileName, positions)) return false;
+      }
+      else {
+         positions = {std::string(startPosition),
+                      "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+                      "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+                      "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+                      "2r3k1/1q1nbppp/r3p3/3pP3/pPpP4/P1Q2N2/2RN1PPP/2R4K b - - 0 23",
+                      "8/8/4k3/8/2p5/8/B2K4/8 w - - 0 1"};
+      }
+      int errors = 0;
+      for (const auto& fen : positions) {
+         RootPosition  p(fen, false);
+         NNUEEvaluator evaluator;
+         p.associateEvaluator(evaluator);
+         p.resetNNUEEvaluator(evaluator);
+         errors += compareKernels<V_SIMD_MAX>(p, evaluator);
+      }
+      if (errors) {
+         Logging::LogIt(Logging::logError) << "Some errors in SIMD testing (" << errors << " on " << positions.size() << " positions)";
+         return false;
+      }
+      Logging::LogIt(Logging::logInfo) << "SIMD " << V_SIMD_MAX << " bits kernels are consistent with 256 bits ones on " << positions.size() << " positions";
+      return true;
+   }
+}
+
+#else
+
+bool TestSIMD(const std::string&) {
+   Logging::LogIt(Logging::logInfo) << "Nothing to compare, this build has no NNUE SIMD kernels";
+   return true;
+}
+
+#endif
@@ -13,7 +13,7 @@ const std::string MinicVersion = "3.47";
 //#define WITH_NNUE_UNCERTAINTY // include uncertainty output head in NNUE
 #define WITH_STATS  // produce or not search statistics
 //#define WITH_BETACUTSTATS // activate beta cutoff statistics
-#define WITH_MATERIAL_TABLE // use (and build ! cost 27Mb) or not the material table
+#define WITH_MATERIAL_TABLE // use or not the material table (entries are computed on first probe)
 //#define WITH_MPI    // support "distributed" version or not
 #define WITH_ASYNC_ANALYZE // support ASYNC call for CLI analysis
 #ifndef _MSC_VER
@@ -32,6 +32,8 @@ const std::string MinicVersion = "3.47";
 // *** Optim (?)
 #define USE_PARTIAL_SORT        // do not sort every move in move list
 //#define WITH_NNUE_PREFETCH    // prefetch NNUE rows before incremental updates
+//#define WITH_NNUE_INT8        // integer inference (int8 weights) for the first NNUE inner layer, see -nnueIntAccuracy
+//#define WITH_NNUE_SPARSE      // first NNUE inner layer only reads weights of non zero inputs (AVX2 and up), see nnueFc0* stats
 //#define WITH_EVALSCORE_AS_INT // in fact just as slow as my basic impl ...
 
 // *** Add-ons
@@ -302,10 +302,54 @@ template<typename T>
 enum GamePhase { MG = 0, EG = 1, GP_MAX = 2 };
 ENABLE_INCR_OPERATORS_ON(GamePhase)
 
-template<typename T, int SIZE> struct OptList : public std::vector<T> {
-   OptList(): std::vector<T>() { std::vector<T>::reserve(SIZE); }
+// fixed capacity list living on the stack (no heap allocation, unlike std::vector)
+// only the used part is copied, elements are not initialized
+template<typename T, size_t CAPACITY> class FixedList {
+  public:
+   using value_type     = T;
+   using size_type      = size_t;
+   using iterator       = T*;
+   using const_iterator = const T*;
+
+   FixedList() = default;
+   FixedList(const FixedList& other): n(other.n) { std::copy_n(other.items, n, items); }
+   FixedList& operator=(const FixedList& other) {
+      n = other.n;
+      std::copy_n(other.items, n, items);
+      return *this;
+   }
+
+   FORCE_FINLINE void push_back(const T& t) {
+      assert(n < CAPACITY);
+      items[n++] = t;
+   }
+   template<typename... Args> FORCE_FINLINE T& emplace_back(Args&&... args) {
+      assert(n < CAPACITY);
+      return items[n++] = T(std::forward<Args>(args)...);
+   }
+   FORCE_FINLINE void pop_back() {
+      assert(n > 0);
+      --n;
+   }
+   FORCE_FINLINE void clear() { n = 0; }
+
+   [[nodiscard]] FORCE_FINLINE size_t size() const { return n; }
+   [[nodiscard]] FORCE_FINLINE bool   empty() const { return n == 0; }
+   [[nodiscard]] static constexpr size_t capacity() { return CAPACITY; }
+
+   [[nodiscard]] FORCE_FINLINE T&       operator[](const size_t k) { assert(k < n); return items[k]; }
+   [[nodiscard]] FORCE_FINLINE const T& operator[](const size_t k) const { assert(k < n); return items[k]; }
+
+   [[nodiscard]] FORCE_FINLINE iterator       begin() { return items; }
+   [[nodiscard]] FORCE_FINLINE iterator       end() { return items + n; }
+   [[nodiscard]] FORCE_FINLINE const_iterator begin() const { return items; }
+   [[nodiscard]] FORCE_FINLINE const_iterator end() const { return items + n; }
+
+  private:
+   T      items[CAPACITY];
+   size_t n = 0;
 };
-using MoveList = OptList<Move, MAX_MOVE / 4>; ///@todo tune this ?
+using MoveList = FixedList<Move, MAX_MOVE>;
 using PVList = std::vector<Move>;
 
 [[nodiscard]] constexpr MiniHash Hash64to32(Hash h) { return static_cast<MiniHash>((h >> 32) & 0xFFFFFFFF); }
@@ -8,10 +8,17 @@ bool         disableTT        = false;
 #if defined(WITH_SMALL_MEMORY)
 unsigned int ttSizeMb         = 2; // here in Kb in fact (SIZE_MULTIPLIER), will be converted to real size next
 unsigned int ttPawnSizeMb     = 1;  // here in Kb in fact (SIZE_MULTIPLIER), will be converted to real size next
+unsigned int evalCacheSizeMb  = 1;  // here in Kb in fact (SIZE_MULTIPLIER), will be converted to real size next
 #else
 unsigned int ttSizeMb         = 128; // here in Mb, will be converted to real size next
 unsigned int ttPawnSizeMb     = 16;  // here in Mb, will be converted to real size next
+unsigned int evalCacheSizeMb  = 16;  // here in Mb, will be converted to real size next
 #endif
+std::string  ttAllocation     = "default";
+std::string  ttFile           = "";
+bool         ttSaveOnExit     = false;
+std::string  ttSharedMemory   = "";
+std::string  isa              = "auto";
 bool         fullXboardOutput = false;
 bool         debugMode        = false;
 int          minOutputLevel   = Logging::logGUI;
@@ -19,11 +26,15 @@ std::string  debugFile        = "minic.debug";
 unsigned int level            = 100;
 unsigned int randomOpen       = 0;
 unsigned int threads          = 1;
+unsigned int helperStartDepth = 2;
+std::string  threadBinding    = "none";
+bool         deterministicSMP = false;
 std::string  syzygyPath       = "";
 bool         FRC              = false;
 bool         DFRC             = false;
 bool         UCIPonder        = false;
 unsigned int multiPV          = 1;
+bool         parallelMultiPV  = true;
 ScoreType    contempt         = 14;
 ScoreType    contemptMG       = 9;
 bool         limitStrength    = false;
@@ -12,6 +12,12 @@ extern bool         mateFinder;
 extern bool         disableTT;
 extern unsigned int ttSizeMb;
 extern unsigned int ttPawnSizeMb;
+extern unsigned int evalCacheSizeMb;
+extern std::string  ttAllocation; // default, hugepages or numa
+extern std::string  ttFile;       // persistent TT file
+extern bool         ttSaveOnExit;
+extern std::string  ttSharedMemory; // name of a POSIX shared memory segment holding the TT
+extern std::string  isa; // auto, avx512, avx2 or generic (ISA dispatch builds only)
 extern bool         fullXboardOutput;
 extern bool         debugMode; // activate output in a file (see debugFile)
 extern int          minOutputLevel; // minimum output level
@@ -19,11 +25,15 @@ extern std::string  debugFile;
 extern unsigned int level;
 extern unsigned int randomOpen;
 extern unsigned int threads;
+extern unsigned int helperStartDepth; // depth reached by the main thread before helper threads start searching
+extern std::string  threadBinding; // none, compact or spread
+extern bool         deterministicSMP; // threads take turns so that a multi-threaded search is reproducible
 extern std::string  syzygyPath;
 extern bool         FRC;
 extern bool         DFRC;
 extern bool         UCIPonder;
 extern unsigned int multiPV;
+extern bool         parallelMultiPV; // with more than one thread, PV lines are searched at the same time by different threads
 extern ScoreType    contempt;
 extern ScoreType    contemptMG;
 extern bool         limitStrength;
@@ -161,16 +161,19 @@ ScoreType NNUEEVal(const Position & p, EvalData &data, Searcher &context, EvalFe
    // or phase
    //const int bucketDivisor = 32/p.evaluator().weights.nbuckets;
    //const int bucket = std::max(0, std::min(p.evaluator().weights.nbuckets-1, (std::min(32,static_cast<int>(BB::countBit(p.occupancy()))-1) / bucketDivisor)));
-   int bucket = 0;
-   if (data.gp < 0.45f)
-      bucket = 0;
-   else
-      bucket = 1;
+   const int bucket = NNUEWrapper::bucket(data.gp);
    
+   // accumulator updates are lazy inside search, see Searcher::materializeNNUE
+   if (p.evaluator().dirty) context.materializeNNUE(p);
+
    // call the net
    const auto evalResult = p.evaluator().propagate(p.c, bucket);
    ScoreType nnueScore = static_cast<ScoreType>(evalResult.evaluation);
    data.uncertainty = evalResult.uncertainty;
+   if (evalResult.activeInputs >= 0) {
+      context.stats.add(Stats::sid_nnueFc0Inputs, 2 * nnue::firstInnerLayerSize);
+      context.stats.add(Stats::sid_nnueFc0Active, static_cast<Counter>(evalResult.activeInputs));
+   }
 
    // fuse MG and EG score applying the EG scaling factor ///@todo, doesn't the net already learned that ????
    nnueScore = ScaleScore({nnueScore, nnueScore}, data.gp, features.scalingFactor);
@@ -239,7 +242,7 @@ ScoreType eval(const Position &p, EvalData &data, Searcher &context, bool forceN
    if (const Hash matHash = MaterialHash::getMaterialHash(p.mat); matHash != nullHash) {
       context.stats.incr(Stats::sid_materialTableHits);
       // Get material hash data
-      const MaterialHash::MaterialHashEntry &MEntry = MaterialHash::materialHashTable[matHash];
+      const MaterialHash::MaterialHashEntry MEntry = MaterialHash::getMaterialEntry(matHash);
       // update EvalData and EvalFeatures
       data.gp = MEntry.gamePhase();
       features.scores[F_material] += MEntry.score;
@@ -265,7 +268,7 @@ ScoreType eval(const Position &p, EvalData &data, Searcher &context, bool forceN
                STOP_AND_SUM_TIMER(Eval)
                context.stats.incr(Stats::sid_materialTableHelper);
                const ScoreType materialTableScore =
-                   (white2Play ? +1 : -1) * (MaterialHash::helperTable[matHash](p, winningSideEG, features.scores[F_material][EG], context.height_));
+                   (white2Play ? +1 : -1) * (MaterialHash::getHelper(matHash)(p, winningSideEG, features.scores[F_material][EG], context.height_));
                return variantScore(materialTableScore, p.halfmoves, context.height_, p.c);
             }
             // real FIDE draws (shall not happens for now in fact ///@todo !!!)
@@ -0,0 +1,123 @@
+#include "isa.hpp"
+
+#include "attack.hpp"
+#include "dynamicConfig.hpp"
+#include "logging.hpp"
+
+#ifdef WITH_NNUE
+#include "nnue.hpp"
+#endif
+
+#if (defined(__GNUC__) || defined(__clang__)) && (defined(__x86_64__) || defined(__i386__))
+#include <cpuid.h>
+#define ISA_WITH_CPUID
+#endif
+
+#if defined(WITH_ISA_DISPATCH) && !defined(ISA_WITH_CPUID)
+#error "ISA dispatch builds need gcc or clang on x86"
+#endif
+
+namespace ISA {
+
+namespace {
+
+[[nodiscard]] CPUFeatures detect() {
+   CPUFeatures f;
+#ifdef ISA_WITH_CPUID
+   unsigned int a = 0, b = 0, c = 0, d = 0;
+   if (__get_cpuid(0, &a, &b, &c, &d)) {
+      char vendor[13];
+      std::memcpy(vendor, &b, 4);
+      std::memcpy(vendor + 4, &d, 4);
+      std::memcpy(vendor + 8, &c, 4);
+      vendor[12] = '\0';
+      f.vendor   = vendor;
+   }
+   if (__get_cpuid(1, &a, &b, &c, &d)) {
+      f.family = (a >> 8) & 0xF;
+      if (f.family == 0xF) f.family += (a >> 20) & 0xFF;
+   }
+   // those also check that the OS saves the wide registers
+   __builtin_cpu_init();
+   f.sse41      = __builtin_cpu_supports("sse4.1");
+   f.avx2       = __builtin_cpu_supports("avx2");
+   f.fma        = __builtin_cpu_supports("fma");
+   f.bmi2       = __builtin_cpu_supports("bmi2");
+   f.avx512     = __builtin_cpu_supports("avx512f") && __builtin_cpu_supports("avx512bw") &&
+                  __builtin_cpu_supports("avx512vl") && __builtin_cpu_supports("avx512dq");
+   f.avx512vnni = __builtin_cpu_supports("avx512vnni");
+   // Zen 1 and 2 (family 0x17, 0x18 for Hygon) and older AMD CPUs have a very slow PEXT
+   const bool amd = f.vendor == "AuthenticAMD" || f.vendor == "HygonGenuine";
+   f.fastPext     = f.bmi2 && !(amd && f.family < 0x19);
+#endif
+   return f;
+}
+
+[[nodiscard]] std::string attackLookup() {
+#ifdef WITH_MAGIC
+   return BBTools::MagicBB::indexMethod();
+#else
+   return "hyperbola quintessence";
+#endif
+}
+
+#ifdef WITH_ISA_DISPATCH
+bool selected = false;
+#endif
+
+} // namespace
+
+#ifdef WITH_NNUE
+std::string nnueKernels() {
+#if defined(WITH_ISA_DISPATCH)
+   return nnue::isaKernels.name;
+#elif defined(USE_SIMD_INTRIN)
+   return V_SIMD_MAX == 512 ? "avx512" : V_SIMD_MAX == 256 ? "avx2" : V_SIMD_MAX == 128 ? "sse" : "generic";
+#else
+   return "scalar";
+#endif
+}
+#endif
+
+const CPUFeatures& cpu() {
+   static const CPUFeatures features = detect();
+   return features;
+}
+
+void init() {
+   const CPUFeatures& f = cpu();
+   Logging::LogIt(Logging::logInfo) << "CPU " << f.vendor << " family " << f.family << ", avx2 " << f.avx2 << ", bmi2 " << f.bmi2 << " (fast pext "
+                                    << f.fastPext << "), avx512 " << f.avx512 << ", avx512vnni " << f.avx512vnni;
+
+#ifdef WITH_ISA_DISPATCH
+   // "auto" or the widest target allowed
+   const std::string& wanted   = DynamicConfig::isa;
+   const bool         allow512 = wanted == "auto" || wanted == "avx512";
+   const bool         allow256 = allow512 || wanted == "avx2";
+   if ((wanted == "avx512" && !f.avx512) || (wanted == "avx2" && !(f.avx2 && f.fma)))
+      Logging::LogIt(Logging::logWarn) << "ISA " << wanted << " is not supported by this CPU";
+
+#ifdef WITH_NNUE
+   if (allow512 && f.avx512) nnue::isaKernels = nnue::isaKernelsAVX512;
+   else if (allow256 && f.avx2 && f.fma) nnue::isaKernels = nnue::isaKernelsAVX2;
+   else nnue::isaKernels = nnue::isaKernelsGeneric;
+#endif
+
+#if defined(WITH_MAGIC) && defined(ENV64BIT)
+   const bool pext = allow256 && f.fastPext;
+   if (pext != BBTools::MagicBB::usePext) {
+      BBTools::MagicBB::usePext = pext;
+      // attack tables layout depends on the index function
+      if (selected) BBTools::MagicBB::initMagic();
+   }
+#endif
+   selected = true;
+#endif
+
+   Logging::LogIt(Logging::logInfoPrio) << "Attack lookup : " << attackLookup();
+#ifdef WITH_NNUE
+   Logging::LogIt(Logging::logInfoPrio) << "NNUE kernels  : " << nnueKernels();
+#endif
+}
+
+} // namespace ISA
@@ -0,0 +1,35 @@
+#pragma once
+
+#include "definition.hpp"
+
+/*!
+ * Instruction set of the running CPU (read once with cpuid)
+ * ISA dispatch builds (WITH_ISA_DISPATCH) compile the attack lookup and the NNUE kernels
+ * for several targets, the ones to use are selected here at startup.
+ * Other builds use what was chosen at compile time, it is only reported.
+ */
+namespace ISA {
+
+struct CPUFeatures {
+   std::string vendor;
+   int         family     = 0;
+   bool        sse41      = false;
+   bool        avx2       = false;
+   bool        fma        = false;
+   bool        bmi2       = false;
+   bool        fastPext   = false; // PEXT is microcoded on AMD CPUs before Zen 3
+   bool        avx512     = false; // F, BW, VL and DQ
+   bool        avx512vnni = false;
+};
+
+[[nodiscard]] const CPUFeatures& cpu();
+
+#ifdef WITH_NNUE
+// name of the NNUE kernels in use
+[[nodiscard]] std::string nnueKernels();
+#endif
+
+// select the attack lookup and NNUE kernels (see DynamicConfig::isa), must be called before initMagic
+void init();
+
+} // namespace ISA
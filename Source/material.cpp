@@ -7,14 +7,57 @@
 #include "logging.hpp"
 #include "positionTools.hpp"
 #include "tools.hpp"
+#include <unordered_map>
 
 namespace MaterialHash { // idea from Gull
 
-// helper function function pointer table
-ScoreType (*helperTable[TotalMat])(const Position &, Color, ScoreType, DepthType);
+namespace {
+// end-game knowledge only concerns a few hundred material configurations
+// those maps are filled once in MaterialHashInitializer::init and only read afterwards
+std::unordered_map<Hash, Terminaison> terminaisons;
+std::unordered_map<Hash, Helper>      helpers;
+
+// the material cache : a direct-mapped table of packed entries that are computed on first probe.
+// Each slot is a single 64 bits word so that concurrent probes/writes from search threads are safe without lock
+// (two threads may compute the same entry, they will write the same value).
+// layout : mg score (16) | eg score (16) | game phase (8) | terminaison (8) | high bits of the material hash (15) | valid (1)
+inline constexpr int      materialCacheBits = 16;
+inline constexpr uint64_t materialCacheSize = 1ull << materialCacheBits;
+inline constexpr uint64_t materialCacheValid = 1ull << 63;
+static_assert(TotalMat >> materialCacheBits < (1 << 15), "material hash high bits do not fit in a cache slot");
+
+array1d<std::atomic<uint64_t>, materialCacheSize> materialCache; // zero initialized, so all slots are invalid
+
+// resident memory of the process in Kb, as reported in /proc/self/status (0 if not available)
+[[nodiscard]] size_t residentMemoryKb() {
+   std::ifstream f("/proc/self/status");
+   for (std::string line; std::getline(f, line);) {
+      if (line.rfind("VmRSS:", 0) != 0) continue;
+      std::istringstream iss(line.substr(6));
+      size_t kb = 0;
+      iss >> kb;
+      return kb;
+   }
+   return 0;
+}
 
-// the material cache
-array1d<MaterialHashEntry,TotalMat> materialHashTable;
+[[nodiscard]] FORCE_FINLINE uint64_t packEntry(const Hash h, const MaterialHashEntry &e) {
+   return static_cast<uint64_t>(static_cast<uint16_t>(e.score[MG]))
+        | static_cast<uint64_t>(static_cast<uint16_t>(e.score[EG])) << 16
+        | static_cast<uint64_t>(e.gp) << 32
+        | static_cast<uint64_t>(e.t) << 40
+        | (h >> materialCacheBits) << 48
+        | materialCacheValid;
+}
+
+[[nodiscard]] FORCE_FINLINE MaterialHashEntry unpackEntry(const uint64_t w) {
+   MaterialHashEntry e;
+   e.score = EvalScore(static_cast<ScoreType>(static_cast<uint16_t>(w)), static_cast<ScoreType>(static_cast<uint16_t>(w >> 16)));
+   e.gp    = static_cast<uint8_t>(w >> 32);
+   e.t     = static_cast<Terminaison>(static_cast<uint8_t>(w >> 40));
+   return e;
+}
+} // namespace
 
 #ifndef WITH_MATERIAL_TABLE
 [[nodiscard]] Hash getMaterialHash(const Position::Material &) {
@@ -226,58 +269,89 @@ EvalScore Imbalance(const Position::Material &mat, Color c) {
 #pragma GCC diagnostic push
 #pragma GCC diagnostic ignored "-Wconversion"
 
-void InitMaterialScore(bool display) {
-   if (display) Logging::LogIt(Logging::logInfo) << "Material hash init";
-   for (int k = 0; k < TotalMat; ++k) {
-      const Position::Material mat = indexToMat(k);
-      // MG
-      const ScoreType matPieceScoreW = mat[Co_White][M_q] * absValue(P_wq) + mat[Co_White][M_r] * absValue(P_wr) +
-                                       mat[Co_White][M_b] * absValue(P_wb) + mat[Co_White][M_n] * absValue(P_wn);
-      const ScoreType matPieceScoreB = mat[Co_Black][M_q] * absValue(P_wq) + mat[Co_Black][M_r] * absValue(P_wr) +
-                                       mat[Co_Black][M_b] * absValue(P_wb) + mat[Co_Black][M_n] * absValue(P_wn);
-      const ScoreType matPawnScoreW = mat[Co_White][M_p] * absValue(P_wp);
-      const ScoreType matPawnScoreB = mat[Co_Black][M_p] * absValue(P_wp);
-      const ScoreType matScoreW     = matPieceScoreW + matPawnScoreW;
-      const ScoreType matScoreB     = matPieceScoreB + matPawnScoreB;
-      // EG
-      const ScoreType matPieceScoreWEG = mat[Co_White][M_q] * absValueEG(P_wq) + mat[Co_White][M_r] * absValueEG(P_wr) +
-                                         mat[Co_White][M_b] * absValueEG(P_wb) + mat[Co_White][M_n] * absValueEG(P_wn);
-      const ScoreType matPieceScoreBEG = mat[Co_Black][M_q] * absValueEG(P_wq) + mat[Co_Black][M_r] * absValueEG(P_wr) +
-                                         mat[Co_Black][M_b] * absValueEG(P_wb) + mat[Co_Black][M_n] * absValueEG(P_wn);
-      const ScoreType matPawnScoreWEG = mat[Co_White][M_p] * absValueEG(P_wp);
-      const ScoreType matPawnScoreBEG = mat[Co_Black][M_p] * absValueEG(P_wp);
-      const ScoreType matScoreWEG     = matPieceScoreWEG + matPawnScoreWEG;
-      const ScoreType matScoreBEG     = matPieceScoreBEG + matPawnScoreBEG;
+[[nodiscard]] MaterialHashEntry computeMaterialEntry(const Hash h) {
+   MaterialHashEntry entry;
+   const Position::Material mat = indexToMat(static_cast<int>(h));
+   // MG
+   const ScoreType matPieceScoreW = mat[Co_White][M_q] * absValue(P_wq) + mat[Co_White][M_r] * absValue(P_wr) +
+                                    mat[Co_White][M_b] * absValue(P_wb) + mat[Co_White][M_n] * absValue(P_wn);
+   const ScoreType matPieceScoreB = mat[Co_Black][M_q] * absValue(P_wq) + mat[Co_Black][M_r] * absValue(P_wr) +
+                                    mat[Co_Black][M_b] * absValue(P_wb) + mat[Co_Black][M_n] * absValue(P_wn);
+   const ScoreType matPawnScoreW = mat[Co_White][M_p] * absValue(P_wp);
+   const ScoreType matPawnScoreB = mat[Co_Black][M_p] * absValue(P_wp);
+   const ScoreType matScoreW     = matPieceScoreW + matPawnScoreW;
+   const ScoreType matScoreB     = matPieceScoreB + matPawnScoreB;
+   // EG
+   const ScoreType matPieceScoreWEG = mat[Co_White][M_q] * absValueEG(P_wq) + mat[Co_White][M_r] * absValueEG(P_wr) +
+                                      mat[Co_White][M_b] * absValueEG(P_wb) + mat[Co_White][M_n] * absValueEG(P_wn);
+   const ScoreType matPieceScoreBEG = mat[Co_Black][M_q] * absValueEG(P_wq) + mat[Co_Black][M_r] * absValueEG(P_wr) +
+                                      mat[Co_Black][M_b] * absValueEG(P_wb) + mat[Co_Black][M_n] * absValueEG(P_wn);
+   const ScoreType matPawnScoreWEG = mat[Co_White][M_p] * absValueEG(P_wp);
+   const ScoreType matPawnScoreBEG = mat[Co_Black][M_p] * absValueEG(P_wp);
+   const ScoreType matScoreWEG     = matPieceScoreWEG + matPawnScoreWEG;
+   const ScoreType matScoreBEG     = matPieceScoreBEG + matPawnScoreBEG;
 #ifdef WITH_EVAL_TUNING
-      const EvalScore imbalanceW = {0, 0};
-      const EvalScore imbalanceB = {0, 0};
+   const EvalScore imbalanceW = {0, 0};
+   const EvalScore imbalanceB = {0, 0};
 #else
-      const EvalScore imbalanceW = Imbalance(mat, Co_White);
-      const EvalScore imbalanceB = Imbalance(mat, Co_Black);
+   const EvalScore imbalanceW = Imbalance(mat, Co_White);
+   const EvalScore imbalanceB = Imbalance(mat, Co_Black);
 #endif
-      ScoreType dummyW = 0;
-      ScoreType dummyB = 0;
-      materialHashTable[k].setGamePhase(gamePhase(mat, dummyW, dummyB));
-      materialHashTable[k].score =
-      EvalScore(imbalanceW[MG] + matScoreW - (imbalanceB[MG] + matScoreB), imbalanceW[EG] + matScoreWEG - (imbalanceB[EG] + matScoreBEG));
-   }
-   if (display) Logging::LogIt(Logging::logInfo) << "...Done";
+   ScoreType dummyW = 0;
+   ScoreType dummyB = 0;
+   entry.setGamePhase(gamePhase(mat, dummyW, dummyB));
+   entry.score =
+   EvalScore(imbalanceW[MG] + matScoreW - (imbalanceB[MG] + matScoreB), imbalanceW[EG] + matScoreWEG - (imbalanceB[EG] + matScoreBEG));
+   if (const auto it = terminaisons.find(h); it != terminaisons.end()) entry.t = it->second;
+   return entry;
 }
 
 #pragma GCC diagnostic pop
 
+void InitMaterialScore(bool display) {
+   if (display) Logging::LogIt(Logging::logInfo) << "Material cache reset";
+   for (auto &slot : materialCache) slot.store(0, std::memory_order_relaxed);
+}
+
+MaterialHashEntry getMaterialEntry(const Hash h) {
+   assert(h != nullHash && h < static_cast<Hash>(TotalMat));
+   std::atomic<uint64_t> &slot = materialCache[h & (materialCacheSize - 1)];
+   const uint64_t w = slot.load(std::memory_order_relaxed);
+   if ((w & materialCacheValid) && ((w & ~materialCacheValid) >> 48) == (h >> materialCacheBits)) return unpackEntry(w);
+   const MaterialHashEntry entry = computeMaterialEntry(h);
+   slot.store(packEntry(h, entry), std::memory_order_relaxed);
+   return entry;
+}
+
+Helper getHelper(const Hash h) {
+   const auto it = helpers.find(h);
+   return it != helpers.end() ? it->second : &helperDummy;
+}
+
+MaterialHashInitializer::MaterialHashInitializer(const Position::Material &mat, Terminaison t) {
+   terminaisons[getMaterialHash(mat)] = t;
+}
+
+MaterialHashInitializer::MaterialHashInitializer(const Position::Material &mat, Terminaison t, Helper helper) {
+   terminaisons[getMaterialHash(mat)] = t;
+   helpers[getMaterialHash(mat)]      = helper;
+}
+
 void MaterialHashInitializer::init() {
+   const auto   start    = Clock::now();
+   const size_t startRSS = residentMemoryKb();
    Logging::LogIt(Logging::logInfo) << "Material hash total : " << TotalMat;
-   Logging::LogIt(Logging::logInfo) << "Material hash size : " << TotalMat * sizeof(MaterialHashEntry) / 1024 / 1024 << "Mb";
+   Logging::LogIt(Logging::logInfo) << "Material cache size : " << materialCacheSize * sizeof(uint64_t) / 1024 << "Kb (" << materialCacheSize << " entries, computed on first probe)";
 
 #ifdef WITH_MATERIAL_TABLE
    InitMaterialScore();
-   for (size_t k = 0; k < TotalMat; ++k) helperTable[k] = &helperDummy;
+   terminaisons.clear();
+   helpers.clear();
 
 #define DEF_MAT(x,t)     const Position::Material MAT##x = materialFromString(TO_STR(x)); MaterialHashInitializer LINE_NAME(dummyMaterialInitializer,MAT##x)( MAT##x ,t   );
 #define DEF_MAT_H(x,t,h) const Position::Material MAT##x = materialFromString(TO_STR(x)); MaterialHashInitializer LINE_NAME(dummyMaterialInitializer,MAT##x)( MAT##x ,t, h);
-#define DEF_MAT_REV(rev,x)     const Position::Material MAT##rev = MaterialHash::getMatReverseColor(MAT##x); MaterialHashInitializer LINE_NAME(dummyMaterialInitializerRev,MAT##x)( MAT##rev,reverseTerminaison(materialHashTable[getMaterialHash(MAT##x)].t)   );
-#define DEF_MAT_REV_H(rev,x,h) const Position::Material MAT##rev = MaterialHash::getMatReverseColor(MAT##x); MaterialHashInitializer LINE_NAME(dummyMaterialInitializerRev,MAT##x)( MAT##rev,reverseTerminaison(materialHashTable[getMaterialHash(MAT##x)].t), h);
+#define DEF_MAT_REV(rev,x)     const Position::Material MAT##rev = MaterialHash::getMatReverseColor(MAT##x); MaterialHashInitializer LINE_NAME(dummyMaterialInitializerRev,MAT##x)( MAT##rev,reverseTerminaison(terminaisons[getMaterialHash(MAT##x)])   );
+#define DEF_MAT_REV_H(rev,x,h) const Position::Material MAT##rev = MaterialHash::getMatReverseColor(MAT##x); MaterialHashInitializer LINE_NAME(dummyMaterialInitializerRev,MAT##x)( MAT##rev,reverseTerminaison(terminaisons[getMaterialHash(MAT##x)]), h);
 
    // WARNING : we assume STM has no capture
 
@@ -434,13 +508,17 @@ void MaterialHashInitializer::init() {
 
    ///@todo other (with more pawn ...)
 
+   Logging::LogIt(Logging::logInfo) << "Material end-game knowledge : " << terminaisons.size() << " configurations";
 #endif
+   const size_t    rss      = residentMemoryKb();
+   const long long rssDelta = static_cast<long long>(rss) - static_cast<long long>(startRSS);
+   Logging::LogIt(Logging::logInfo) << "Material hash init done in " << getTimeDiff(start) << "ms, RSS " << rss << "Kb (" << (rssDelta >= 0 ? "+" : "") << rssDelta << "Kb)";
 }
 
 Terminaison probeMaterialHashTable(const Position::Material &mat) {
    const Hash h = getMaterialHash(mat);
    if (h == nullHash) return Ter_Unknown;
-   return materialHashTable[h].t;
+   return getMaterialEntry(h).t;
 }
 
 void updateMaterialOther(Position &p) {
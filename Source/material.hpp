@@ -8,6 +8,8 @@
  * Mostly inspired by Gull by Vadim Demichev
  * after a discussion on talkchess (http://talkchess.com/forum3/viewtopic.php?f=7&t=67558&p=763426)
  * but we allow 2 bishops of the same color
+ * Entries are not built eagerly : scores are computed on first probe and kept in a small lock-free cache,
+ * only the (sparse) end-game knowledge is registered at init.
  */
 
 namespace MaterialHash {
@@ -57,7 +59,7 @@ enum Terminaison : uint8_t {
    Ter_None
 };
 
-extern ScoreType (*helperTable[TotalMat])(const Position &, Color, ScoreType, DepthType);
+using Helper = ScoreType (*)(const Position &, Color, ScoreType, DepthType);
 
 struct MaterialHashEntry {
    EvalScore    score = {0, 0};
@@ -67,18 +69,18 @@ struct MaterialHashEntry {
    FORCE_FINLINE void  setGamePhase(float gpf) { gp = (uint8_t)(255 * gpf); }
 };
 
-extern array1d<MaterialHashEntry,TotalMat> materialHashTable;
+// h must be a valid material hash (not nullHash)
+[[nodiscard]] MaterialHashEntry getMaterialEntry(Hash h);
+[[nodiscard]] Helper            getHelper(Hash h);
 
 [[nodiscard]] EvalScore Imbalance(const Position::Material &mat, Color c);
 
+// forget already computed material scores (to be called when piece values are modified)
 void InitMaterialScore(bool display = true);
 
 struct MaterialHashInitializer {
-   MaterialHashInitializer(const Position::Material &mat, Terminaison t) { materialHashTable[getMaterialHash(mat)].t = t; }
-   MaterialHashInitializer(const Position::Material &mat, Terminaison t, ScoreType (*helper)(const Position &, Color, ScoreType, DepthType)) {
-      materialHashTable[getMaterialHash(mat)].t = t;
-      helperTable[getMaterialHash(mat)]         = helper;
-   }
+   MaterialHashInitializer(const Position::Material &mat, Terminaison t);
+   MaterialHashInitializer(const Position::Material &mat, Terminaison t, Helper helper);
    static void init();
 };
 
@@ -9,6 +9,7 @@
 #include "energyMonitor.hpp"
 #include "evalConfig.hpp"
 #include "hash.hpp"
+#include "isa.hpp"
 #include "kpk.hpp"
 #include "logging.hpp"
 #include "material.hpp"
@@ -39,7 +40,11 @@ inline void init(int argc, char** argv) {
    Logging::hellooo();
    Options::initOptions(argc, argv);
    Logging::init(); // after reading options
+   ISA::init();     // before magic tables, their layout may depend on the CPU
    Zobrist::initHash();
+#ifdef WITH_NNUE
+   NNUEWrapper::init(); // before TT, a persistent TT file is bound to the net
+#endif
    TT::initTable();
    BBTools::initMask();
 #ifdef WITH_MAGIC
@@ -52,9 +57,6 @@ inline void init(int argc, char** argv) {
    Distributed::lateInit();
 #ifdef WITH_SYZYGY
    SyzygyTb::initTB();
-#endif
-#ifdef WITH_NNUE
-   NNUEWrapper::init();
 #endif
    COM::init(COM::p_uci); // let's do this ... (usefull to reset position in case of NNUE)
    sizeOf();
@@ -67,6 +69,7 @@ inline void finalize() {
    ThreadPool::instance().stop();
    Logging::LogIt(Logging::logInfo) << "Waiting all threads";
    ThreadPool::instance().wait(); ///@todo is this necessary ?
+   if (DynamicConfig::ttSaveOnExit && Distributed::isMainProcess()) TT::saveTT(DynamicConfig::ttFile);
    Logging::LogIt(Logging::logInfo) << "Deleting all threads";
    ThreadPool::instance().resize(0);
    Logging::LogIt(Logging::logInfo) << "Syncing process...";
@@ -116,6 +119,7 @@ R"(
  * -plain2bin
  * -pgn2bin
  * -rescore
+ * -convertNNUE [output] : write the net given with -NNUEFile as a pre-quantized (memory-mappable) file
 )";
 #ifdef DEBUG_TOOL
    const std::string h3 =
@@ -126,7 +130,9 @@ R"(
  * -perft_test_long_fischer : run a long perf test for FRC
  * -perft_test_long : run a long perf test
  * -see_test : run a SEE test (most positions taken from Vajolet by Marco Belli a.k.a elcabesa)
- * -evalSpeed [filename] : run an evaluation performance test
+ * -simd_test [filename] : check AVX-512 NNUE kernels against AVX2 ones on some positions (needs -NNUEFile)
+ * -evalSpeed [filename] : run an evaluation performance test (full eval, then net only, one position at a time and batched)
+ * -nnueIntAccuracy [filename] : compare integer and float NNUE inference on an EPD file (needs -NNUEFile)
  * -timeTest [initial=50000] [incr=0] [moveInTC=-1] [guiLag=0] : run a TC simulation
  * bench [depth=16] : used for OpenBench output
  Next commands needs at least a position
@@ -225,6 +231,16 @@ inline bool minic(int argc, char** argv) {
    if (hasParam && std::string(firstArg) == "-pgn") { RETURN(PGNParse(secondArg)) }
 #endif // WITH_PGN_PARSER
 
+#ifdef WITH_NNUE
+   if (hasParam && std::string(firstArg) == "-convertNNUE") {
+      if (!DynamicConfig::useNNUE) {
+         Logging::LogIt(Logging::logError) << "No net loaded, use -NNUEFile to give the net to convert";
+         RETURN(false)
+      }
+      RETURN(NNUEEvaluator::weights.saveMapped(secondArg))
+   }
+#endif // WITH_NNUE
+
 #ifdef WITH_DATA2BIN
    if (hasParam && std::string(firstArg) == "-plain2bin") { 
       RETURN(convert_plain_to_bin({secondArg}, secondArg + ".bin", 1, 300)) 
@@ -333,27 +333,41 @@ bool applyMove(Position& p, const MoveInfo & moveInfo, [[maybe_unused]] const bo
 }
 
 void applyMoveNNUEUpdate([[maybe_unused]] Position & p, [[maybe_unused]] const MoveInfo & moveInfo){
+   applyMoveNNUEUpdate(p, moveInfo, p); // in-place
+}
+
+void applyMoveNNUEUpdate([[maybe_unused]] Position & p, [[maybe_unused]] const MoveInfo & moveInfo, [[maybe_unused]] const Position & parent){
 #ifdef WITH_NNUE
    if (!DynamicConfig::useNNUE) return;
+   // accumulators are built from the parent ones, this way no copy is needed before the update
+   const NNUEEvaluator& parentEvaluator = parent.evaluator();
+   p.evaluator().refreshCache = parentEvaluator.refreshCache;
    // if king is not moving, update nnue evaluator
    // this is based on initial position state (most notably ep square), 
    // all is available in the previously built moveInfo)
-   if (Abs(moveInfo.fromP) != P_wk || (getBlock(moveInfo.from) == getBlock(moveInfo.to))) {
+   if (!isCastling(moveInfo.type) && (Abs(moveInfo.fromP) != P_wk || (getBlock(moveInfo.from) == getBlock(moveInfo.to)))) {
       // ***be carefull here***, p.c has already been updated !!!
-      if (p.c == Co_Black) updateNNUEEvaluator<Co_White>(p.evaluator(), moveInfo);
-      else updateNNUEEvaluator<Co_Black>(p.evaluator(), moveInfo);
+      if (p.c == Co_Black) updateNNUEEvaluator<Co_White>(p.evaluator(), parentEvaluator, moveInfo);
+      else updateNNUEEvaluator<Co_Black>(p.evaluator(), parentEvaluator, moveInfo);
    }
    // if a king was moved (including castling!!), reset nnue evaluator
    // this is based on new position state !
    else { 
-      p.resetNNUEEvaluator(p.evaluator(), ~p.c);
+      p.refreshNNUEEvaluator(p.evaluator(), ~p.c);
       if (isCastling(moveInfo.type)){
-         p.resetNNUEEvaluator(p.evaluator(), p.c);
+         // ***be carefull here***, p.c has already been updated !!!
+         switch (moveInfo.type) {
+            case T_wks: updateNNUEEvaluatorThemOnlyCastling<Co_White>(p.evaluator(), parentEvaluator, moveInfo, p.rootInfo().rooksInit[Co_White][CT_OO],  Sq_f1); break;
+            case T_wqs: updateNNUEEvaluatorThemOnlyCastling<Co_White>(p.evaluator(), parentEvaluator, moveInfo, p.rootInfo().rooksInit[Co_White][CT_OOO], Sq_d1); break;
+            case T_bks: updateNNUEEvaluatorThemOnlyCastling<Co_Black>(p.evaluator(), parentEvaluator, moveInfo, p.rootInfo().rooksInit[Co_Black][CT_OO],  Sq_f8); break;
+            case T_bqs: updateNNUEEvaluatorThemOnlyCastling<Co_Black>(p.evaluator(), parentEvaluator, moveInfo, p.rootInfo().rooksInit[Co_Black][CT_OOO], Sq_d8); break;
+            default: assert(false);
+         }
       }
       else{
          // ***be carefull here***, p.c has already been updated !!!
-         if (p.c == Co_Black) updateNNUEEvaluatorThemOnly<Co_White>(p.evaluator(), moveInfo);
-         else updateNNUEEvaluatorThemOnly<Co_Black>(p.evaluator(), moveInfo);
+         if (p.c == Co_Black) updateNNUEEvaluatorThemOnly<Co_White>(p.evaluator(), parentEvaluator, moveInfo);
+         else updateNNUEEvaluatorThemOnly<Co_Black>(p.evaluator(), parentEvaluator, moveInfo);
       }
    }
 
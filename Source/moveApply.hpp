@@ -25,3 +25,6 @@ void applyNull(Searcher& context, Position& pN);
 bool applyMove(Position& p, const MoveInfo & moveInfo, const bool noNNUEUpdate = false);
 
 void applyMoveNNUEUpdate(Position & p, const MoveInfo & moveInfo);
+
+// same as above but the accumulators are built from the parent position evaluator
+void applyMoveNNUEUpdate(Position & p, const MoveInfo & moveInfo, const Position & parent);
@@ -1,6 +1,8 @@
 #include "moveSort.hpp"
 
 #include "logging.hpp"
+#include "moveGen.hpp"
+#include "movePseudoLegal.hpp"
 #include "searcher.hpp"
 #include "searchConfig.hpp"
 
@@ -163,3 +165,120 @@ const Move* MoveSorter::pickNext(MoveList& moves, size_t& begin, bool skipSort)
    STOP_AND_SUM_TIMER(MoveSorting)
    return &*(moves.begin() + (begin++)); // increment begin !
 }
+
+template<Color C>
+void MovePicker::scoreFrom(const size_t begin) {
+   START_TIMER
+   for (size_t k = begin; k < moves.size(); ++k) ms.computeScore<C>(moves[k]);
+   STOP_AND_SUM_TIMER(MoveScoring)
+}
+
+// killers and counter move come from other positions, they are validated before being tried
+template<Color C>
+void MovePicker::addRefutations() {
+   const Searcher& context = ms.context;
+   const Position& p       = ms.p;
+   const array1d<Move, 4> candidates = {
+       context.killerT.killers[ms.height][0],
+       context.killerT.killers[ms.height][1],
+       ms.height > 1 ? context.killerT.killers[ms.height - 2][0] : INVALIDMOVE,
+       isValidMove(p.lastMove) ? static_cast<Move>(context.counterT.counter[Move2From(p.lastMove)][correctedMove2ToKingDest(p.lastMove)]) : INVALIDMOVE};
+   const size_t begin = moves.size();
+   for (const Move c : candidates) {
+      if (!isValidMove(c)) continue;
+      const MType t = Move2Type(c);
+      if (t != T_std && !isCastling(t)) continue;
+      if (ms.e && sameMove(ms.e->m, c)) continue; // TT move was already tried
+      if (std::any_of(refutations.begin(), refutations.begin() + nbRefutations, [&](const Move r) { return sameMove(r, c); })) continue;
+      if (!isPseudoLegal(p, c)) continue;
+      const Move m = ToMove(Move2From(c), Move2To(c), t, 0);
+      refutations[nbRefutations++] = m;
+      moves.push_back(m);
+   }
+   scoreFrom<C>(begin);
+}
+
+const Move* MovePicker::pick(const bool sorted) {
+   const size_t first = offset + badCaptures;
+   if (first >= moves.size()) return nullptr;
+   if (sorted) {
+      START_TIMER
+      const auto it = std::min_element(moves.begin() + first, moves.end(), MoveSortOperator());
+      std::iter_swap(moves.begin() + first, it);
+      STOP_AND_SUM_TIMER(MoveSorting)
+   }
+   // the waiting bad captures block is shifted by one
+   if (badCaptures) std::swap(moves[offset], moves[first]);
+   return &moves[offset++];
+}
+
+const Move* MovePicker::next() {
+   const bool white = ms.p.c == Co_White;
+   switch (stage) {
+      case ST_genCaptures:
+         MoveGen::generate<MoveGen::GP_cap>(ms.p, moves);
+         if (white) scoreFrom<Co_White>(0);
+         else scoreFrom<Co_Black>(0);
+         stage = ST_goodCaptures;
+         [[fallthrough]];
+      case ST_goodCaptures:
+         if (const Move* m = pick(true); m) {
+            if (!isBadCap(*m)) return m;
+            // all remaining captures are bad ones, they wait for the end
+            --offset;
+            badCaptures = moves.size() - offset;
+         }
+         if (white) addRefutations<Co_White>();
+         else addRefutations<Co_Black>();
+         stage = ST_refutations;
+         [[fallthrough]];
+      case ST_refutations:
+         if (const Move* m = pick(true); m) return m;
+         stage = ST_genQuiets;
+         [[fallthrough]];
+      case ST_genQuiets: {
+         const size_t begin = moves.size();
+         MoveGen::generate<MoveGen::GP_quiet>(ms.p, moves, true);
+         // refutations were already tried
+         if (nbRefutations) {
+            for (size_t k = begin; k < moves.size();) {
+               if (std::any_of(refutations.begin(), refutations.begin() + nbRefutations, [&](const Move r) { return sameMove(r, moves[k]); })) {
+                  moves[k] = moves[moves.size() - 1];
+                  moves.pop_back();
+               }
+               else ++k;
+            }
+         }
+         if (white) scoreFrom<Co_White>(begin);
+         else scoreFrom<Co_Black>(begin);
+         stage = ST_quiets;
+      }
+         [[fallthrough]];
+      case ST_quiets:
+         // as in pickNextLazy, moves with very low chance of raising alpha are not sorted anymore
+         ms.skipSort = ms.skipSort || (offset != 0 && Move2Score(moves[offset - 1]) < SearchConfig::lazySortThreshold);
+         if (const Move* m = pick(!ms.skipSort); m) return m;
+         badCaptures = 0;
+         stage       = ST_badCaptures;
+         [[fallthrough]];
+      case ST_badCaptures:
+         if (const Move* m = pick(true); m) return m;
+         stage = ST_deferred;
+         return next();
+      case ST_all:
+         ms.score(moves);
+         stage = ST_allScored;
+         [[fallthrough]];
+      case ST_allScored:
+         if (const Move* m = ms.pickNextLazy(moves, offset); m) return m;
+         stage = ST_deferred;
+         [[fallthrough]];
+      case ST_deferred:
+         if (nbDeferredPicked < deferred.size()) return &deferred[nbDeferredPicked++];
+         stage = ST_done;
+         return nullptr;
+      case ST_done:
+      default:
+         return nullptr;
+   }
+}
\ No newline at end of file
@@ -91,3 +91,55 @@ struct MoveSorter {
 
    [[nodiscard]] static const Move* pickNext(MoveList& moves, size_t& begin, bool skipSort = false);
 };
+
+/*!
+ * Staged move picker used in pvs, moves are generated and scored only when needed :
+ *    TT move (tried by the search before) -> good captures -> killers and counter -> quiets -> bad captures
+ * At cut nodes, quiet moves generation and scoring are thus often avoided.
+ * Picked moves are kept, in picking order, at the beginning of the move list
+ * (history malus of previously tried moves relies on this).
+ * ST_all is not staged : all moves are already in the list (evasions, root node, TB root moves, variants)
+ * Deferred moves (see ABDADA) are given again once all others were picked.
+ * */
+struct MovePicker {
+   enum Stage : uint8_t { ST_genCaptures = 0, ST_goodCaptures, ST_refutations, ST_genQuiets, ST_quiets, ST_badCaptures, ST_all, ST_allScored, ST_deferred, ST_done };
+
+   MovePicker(MoveSorter& _ms, MoveList& _moves, const Stage _stage): ms(_ms), moves(_moves), stage(_stage) {}
+
+   [[nodiscard]] const Move* next();
+
+   // the last picked move will be given again at the end, returns false if it cannot be deferred
+   [[nodiscard]] bool defer(const Move m) {
+      if (stage == ST_deferred || deferred.size() == deferred.capacity()) return false;
+      deferred.push_back(m);
+      return true;
+   }
+
+   // applies f on the moves given before m, in the order they were given (deferred moves at their deferred position)
+   template<typename F> void forEachBefore(const Move m, F&& f) const {
+      for (size_t k = 0; k < offset; ++k) {
+         if (std::any_of(deferred.begin(), deferred.end(), [&](const Move d) { return sameMove(d, moves[k]); })) continue;
+         if (sameMove(moves[k], m)) return;
+         f(moves[k]);
+      }
+      for (size_t k = 0; k < nbDeferredPicked; ++k) {
+         if (sameMove(deferred[k], m)) return;
+         f(deferred[k]);
+      }
+   }
+
+  private:
+   template<Color C> void scoreFrom(size_t begin);
+   template<Color C> void addRefutations();
+   [[nodiscard]] const Move* pick(bool sorted);
+
+   MoveSorter&     ms;
+   MoveList&       moves;
+   Stage           stage;
+   size_t          offset      = 0; // moves before offset are already picked
+   size_t          badCaptures = 0; // bad captures are waiting in [offset, offset + badCaptures)
+   array1d<Move,4> refutations;
+   size_t          nbRefutations = 0;
+   FixedList<Move, 32> deferred;
+   size_t          nbDeferredPicked = 0;
+};
@@ -7,6 +7,7 @@
 #include "dynamicConfig.hpp"
 #include "logging.hpp"
 #include "nnueImpl.hpp"
+#include "stats.hpp"
 
 // Internal wrapper to the NNUE things
 namespace NNUEWrapper {
@@ -36,10 +37,39 @@ inline void init() {
    }
 }
 
+// inner layers bucket, from game phase
+[[nodiscard]] inline int bucket(const float gp) { return gp < 0.45f ? 0 : 1; }
+
 } // namespace NNUEWrapper
 
 using NNUEEvaluator = nnue::NNUEEval<NNUEWrapper::nnueNType, NNUEWrapper::quantization>;
 
+/*!
+ * Accumulator refresh cache (a.k.a "Finny tables")
+ * For each perspective and king bucket, we keep the last accumulator built with this king bucket
+ * and the pieces it was built from. When a king changes bucket, the accumulator is then obtained
+ * by applying only the difference between those pieces and the current ones (see Position::refreshNNUEEvaluator).
+ * There is one cache per search thread.
+ */
+struct NNUERefreshCache {
+   using BIT = typename nnue::Quantization<NNUEWrapper::quantization>::BIT;
+
+   struct Entry {
+      nnue::StackVector<BIT, nnue::firstInnerLayerSize, NNUEWrapper::quantization> accumulator;
+      colored<array1d<BitBoard, 6>> pieces; // pieces (P_wp to P_wk) of each color used to build the accumulator
+      bool                          valid = false;
+   };
+
+   colored<array1d<Entry, NbSquare>> entries;
+   uint64_t netHash = 0;       // entries are only valid for this net
+   Stats*   stats   = nullptr; // hit/miss are counted there if given
+
+   void clear() {
+      for (auto& perspective : entries)
+         for (auto& e : perspective) e.valid = false;
+   }
+};
+
 #ifdef WITH_DATA2BIN
 #include "learn/convert.hpp"
 #endif
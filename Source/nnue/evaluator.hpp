@@ -12,8 +12,13 @@
 struct EvalWithUncertainty {
    float evaluation;
    float uncertainty;
+   int   activeInputs = -1; // fc0 inputs read by the sparse path (-1 for the dense one), see nnueFc0* stats
 };
 
+#ifdef USE_SIMD_INTRIN
+#include "inference.hpp"
+#endif
+
 template<typename NT, bool Q> 
 struct NNUEEval : Sided<NNUEEval<NT, Q>, FeatureTransformer<NT, Q>> {
    // common data (weights and bias)
@@ -27,6 +32,9 @@ struct NNUEEval : Sided<NNUEEval<NT, Q>, FeatureTransformer<NT, Q>> {
    // if dirty, then an update/reset is necessary
    bool dirty = true;
 
+   // per thread accumulator refresh cache used when a king changes bucket (optional)
+   ::NNUERefreshCache* refreshCache = nullptr;
+
    FORCE_FINLINE void clear() {
       dirty = true;
       white.clear();
@@ -44,49 +52,64 @@ struct NNUEEval : Sided<NNUEEval<NT, Q>, FeatureTransformer<NT, Q>> {
    using BT = typename Quantization<Q>::BT;
    
    EvalWithUncertainty propagate(Color c, const int bucket) const {
+#if defined(WITH_ISA_DISPATCH)
       assert(!dirty);
       assert(bucket >= 0);
       assert(bucket < (NNUEWeights<NT, Q>::nbuckets));
-      
-      constexpr float deqScale = 1.f / Quantization<Q>::scale;
-      const auto& layer = weights.innerLayer[bucket];
+      const auto& first  = (c == Co_White) ? white : black;
+      const auto& second = (c == Co_White) ? black : white;
+      return isaKernels.propagate(first.active().data, second.active().data, bucket);
+#elif defined(USE_SIMD_INTRIN) && defined(WITH_NNUE_INT8)
+      return propagateInt(c, bucket);
+#else
+      return propagateFloat(c, bucket);
+#endif
+   }
 
 #ifdef USE_SIMD_INTRIN
-      StackVector<BT, 2 * firstInnerLayerSize, Q> x0;
-      {
+   // batched inference of n positions (see NNUEBatch), us and them are their accumulators (side to move first)
+   static void propagateBatch(const int16_t* const* us, const int16_t* const* them, const size_t n, const int bucket, EvalWithUncertainty* out) {
+      static_assert(Q, "batched inference needs a quantized accumulator");
+      assert(bucket >= 0);
+      assert(bucket < (NNUEWeights<NT, Q>::nbuckets));
+#if defined(WITH_ISA_DISPATCH)
+      isaKernels.propagateBatch(us, them, n, bucket, out);
+#elif defined(WITH_NNUE_INT8)
+      inference::simdPropagateIntBatch<Q>(us, them, n, weights, bucket, out);
+#else
+      inference::simdPropagateFloatBatch<Q>(us, them, n, weights, bucket, out);
+#endif
+   }
+
+   // integer inference of fc0 (see simdPropagateInt)
+   EvalWithUncertainty propagateInt(Color c, const int bucket) const {
+      if constexpr (!Q) {
+         return propagateFloat(c, bucket);
+      }
+      else {
+         assert(!dirty);
+         assert(bucket >= 0);
+         assert(bucket < (NNUEWeights<NT, Q>::nbuckets));
          const auto& first  = (c == Co_White) ? white : black;
          const auto& second = (c == Co_White) ? black : white;
-         simdDequantizeActivate_i16_f32<firstInnerLayerSize, Q>(
-            x0.data, first.active().data, deqScale);
-         simdDequantizeActivate_i16_f32<firstInnerLayerSize, Q>(
-            x0.data + firstInnerLayerSize, second.active().data, deqScale);
+         return inference::simdPropagateInt<Q>(first.active().data, second.active().data, weights, bucket);
       }
+   }
+#endif
 
-      auto x1 = layer.fc0.forward(x0).activation_();
-
-      StackVector<BT, 16, Q> x2;
-      simdCopy_f32<8>(x2.data, x1.data);
-      layer.fc1.forwardTo(x1, x2.data + 8);
-      simdActivation<8, Q>(x2.data + 8);
-
-      StackVector<BT, 24, Q> x3;
-      simdCopy_f32<16>(x3.data, x2.data);
-      layer.fc2.forwardTo(x2, x3.data + 16);
-      simdActivation<8, Q>(x3.data + 16);
+   EvalWithUncertainty propagateFloat(Color c, const int bucket) const {
+      assert(!dirty);
+      assert(bucket >= 0);
+      assert(bucket < (NNUEWeights<NT, Q>::nbuckets));
 
-      const float eval = layer.fc3.forward(x3).data[0];
-#ifdef WITH_NNUE_UNCERTAINTY
-      const float log_var = layer.fc3_uncertainty.forward(x3).data[0];
-      const float variance = std::exp(std::clamp(log_var, -10.0f, 10.0f));
+#ifdef USE_SIMD_INTRIN
+      const auto& first  = (c == Co_White) ? white : black;
+      const auto& second = (c == Co_White) ? black : white;
+      return inference::simdPropagateFloat<Q>(first.active().data, second.active().data, weights, bucket);
 #else
-      constexpr float variance = 1.0f;
-#endif
-      
-#if defined(__AVX2__)
-      _mm256_zeroupper();
-#endif
+      constexpr float deqScale = 1.f / Quantization<Q>::scale;
+      const auto& layer = weights.innerLayer[bucket];
 
-#else
       // Non-SIMD fallback
       const auto w_x {white.active().dequantize(deqScale)
                                .apply_(activationInput<BT, Q>)
@@ -108,9 +131,9 @@ struct NNUEEval : Sided<NNUEEval<NT, Q>, FeatureTransformer<NT, Q>> {
       const float variance = std::exp(std::clamp(log_var, -10.0f, 10.0f));
 #else
       constexpr float variance = 1.0f;
-#endif
 #endif
       return {eval * Quantization<Q>::outFactor, variance};
+#endif
    }
 
 #ifdef DEBUG_NNUE_UPDATE
@@ -51,6 +51,23 @@ struct FeatureTransformer {
       weights_->eraseIdx(idx, active_);
    }
 
+   // fused updates from the parent accumulator (may be this one) : active_ = parent - sub + add
+   // a quiet move is add1-sub1, a capture add1-sub2, castling add2-sub2
+   FORCE_FINLINE void addSub(const FeatureTransformer<NT, Q>& parent, const size_t add0, const size_t sub0) {
+      assert(weights_);
+      active_.template addSubFrom_<1, 1>(parent.active_, std::array{weights_->row(add0)}, std::array{weights_->row(sub0)});
+   }
+
+   FORCE_FINLINE void addSubSub(const FeatureTransformer<NT, Q>& parent, const size_t add0, const size_t sub0, const size_t sub1) {
+      assert(weights_);
+      active_.template addSubFrom_<1, 2>(parent.active_, std::array{weights_->row(add0)}, std::array{weights_->row(sub0), weights_->row(sub1)});
+   }
+
+   FORCE_FINLINE void addAddSubSub(const FeatureTransformer<NT, Q>& parent, const size_t add0, const size_t add1, const size_t sub0, const size_t sub1) {
+      assert(weights_);
+      active_.template addSubFrom_<2, 2>(parent.active_, std::array{weights_->row(add0), weights_->row(add1)}, std::array{weights_->row(sub0), weights_->row(sub1)});
+   }
+
    FeatureTransformer(const InputLayer<NT, inputLayerSize, firstInnerLayerSize, Q>* src): weights_ {src} { clear(); }
 
    FeatureTransformer() = delete;
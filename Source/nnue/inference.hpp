@@ -0,0 +1,172 @@
+// SIMD inference of the inner layers, from the two accumulators (side to move first).
+// There is no include guard on purpose : like the kernels it uses, this is compiled again
+// for each extra target of ISA dispatch builds (see simdDispatch.cpp).
+// The nested namespace keeps those functions out of argument dependent lookup on nnue types,
+// so that each target only sees its own ones.
+
+namespace inference {
+
+// dst = b + W.x (inner layers weights are stored transposed, one row per output)
+template<typename NT, size_t dim0, size_t dim1, bool Q>
+FORCE_FINLINE void simdForward(const Layer<NT, dim0, dim1, Q>& layer, const float* RESTRICT x, float* RESTRICT dst) {
+   for (size_t i = 0; i < dim1; ++i) { dst[i] = layer.b[i] + simdDotProduct<dim0, Q>(x, layer.W + i * dim0); }
+}
+
+template<size_t dim0, size_t dim1>
+FORCE_FINLINE void simdForwardInt8(const Int8Layer<dim0, dim1>& layer, const uint8_t* RESTRICT x, float* RESTRICT dst) {
+   for (size_t i = 0; i < dim1; ++i) { dst[i] = layer.b[i] + layer.deqScale[i] * static_cast<float>(simdDotProduct_u8i8<dim0>(x, layer.W + i * dim0)); }
+}
+
+// fc0 of the given bucket, returns the number of inputs read by the sparse path (-1 for the dense one).
+// After the clipped ReLU most inputs are exactly zero, the sparse path only accumulates the weights
+// of the non zero ones (see SparseLayer).
+template<typename WeightsT>
+FORCE_FINLINE int simdForwardFc0(const WeightsT& weights, const int bucket, const float* RESTRICT x0, float* RESTRICT x) {
+#if defined(WITH_NNUE_SPARSE) && defined(SIMD_AVX2)
+   alignas(NNUEALIGNMENT) uint16_t nnz[2 * firstInnerLayerSize];
+   const size_t count = simdNonZero_f32<2 * firstInnerLayerSize>(x0, nnz);
+   simdSparseAffine8_f32(x0, nnz, count, weights.fc0Sparse[bucket].W, weights.innerLayer[bucket].fc0.b, x);
+   return static_cast<int>(count);
+#else
+   simdForward(weights.innerLayer[bucket].fc0, x0, x);
+   return -1;
+#endif
+}
+
+// same for the integer path, the sparse path works on blocks of 4 inputs
+template<typename WeightsT>
+FORCE_FINLINE int simdForwardFc0Int8(const WeightsT& weights, const int bucket, const uint8_t* RESTRICT x0, float* RESTRICT x) {
+   const auto& fc0 = weights.fc0Int[bucket];
+#if defined(WITH_NNUE_SPARSE) && defined(SIMD_AVX2)
+   alignas(NNUEALIGNMENT) uint16_t nnz[2 * firstInnerLayerSize / 4];
+   alignas(NNUEALIGNMENT) int32_t  acc[8];
+   const size_t count = simdNonZero_u8x4<2 * firstInnerLayerSize>(x0, nnz);
+   simdSparseAffine8_u8i8(x0, nnz, count, weights.fc0Sparse[bucket].W8, acc);
+   for (size_t i = 0; i < 8; ++i) x[i] = fc0.b[i] + fc0.deqScale[i] * static_cast<float>(acc[i]);
+   return static_cast<int>(4 * count);
+#else
+   simdForwardInt8(fc0, x0, x);
+   return -1;
+#endif
+}
+
+// small layers after fc0, always in float (they are tiny compared to fc0)
+// each layer output is appended to its input, x holds the 8 activated outputs of fc0
+template<bool Q, typename InnerLayerT>
+FORCE_FINLINE EvalWithUncertainty simdPropagateTail(const InnerLayerT& layer, float* x, const int activeInputs) {
+   simdForward(layer.fc1, x, x + 8);
+   simdActivation<8, Q>(x + 8);
+   simdForward(layer.fc2, x, x + 16);
+   simdActivation<8, Q>(x + 16);
+
+   float eval;
+   simdForward(layer.fc3, x, &eval);
+#ifdef WITH_NNUE_UNCERTAINTY
+   float log_var;
+   simdForward(layer.fc3_uncertainty, x, &log_var);
+   const float variance = std::exp(std::clamp(log_var, -10.0f, 10.0f));
+#else
+   constexpr float variance = 1.0f;
+#endif
+
+#ifdef SIMD_AVX2
+   _mm256_zeroupper();
+#endif
+   return {eval * Quantization<Q>::outFactor, variance, activeInputs};
+}
+
+template<bool Q, typename WeightsT>
+EvalWithUncertainty simdPropagateFloat(const int16_t* us, const int16_t* them, const WeightsT& weights, const int bucket) {
+   constexpr float deqScale = 1.f / Quantization<Q>::scale;
+   alignas(NNUEALIGNMENT) float x0[2 * firstInnerLayerSize];
+   simdDequantizeActivate_i16_f32<firstInnerLayerSize, Q>(x0, us, deqScale);
+   simdDequantizeActivate_i16_f32<firstInnerLayerSize, Q>(x0 + firstInnerLayerSize, them, deqScale);
+
+   alignas(NNUEALIGNMENT) float x[24];
+   const int activeInputs = simdForwardFc0(weights, bucket, x0, x);
+   simdActivation<8, Q>(x);
+   return simdPropagateTail<Q>(weights.innerLayer[bucket], x, activeInputs);
+}
+
+// integer inference : uint8 activations and int8 weights for fc0 (see Int8Layer),
+// only possible with a quantized accumulator
+template<bool Q, typename WeightsT>
+EvalWithUncertainty simdPropagateInt(const int16_t* us, const int16_t* them, const WeightsT& weights, const int bucket) {
+   static_assert(Q, "integer inference needs a quantized accumulator");
+   alignas(NNUEALIGNMENT) uint8_t x0[2 * firstInnerLayerSize];
+   simdActivateU8_i16<firstInnerLayerSize>(x0, us);
+   simdActivateU8_i16<firstInnerLayerSize>(x0 + firstInnerLayerSize, them);
+
+   alignas(NNUEALIGNMENT) float x[24];
+   const int activeInputs = simdForwardFc0Int8(weights, bucket, x0, x);
+   simdActivation<8, Q>(x);
+   return simdPropagateTail<Q>(weights.innerLayer[bucket], x, activeInputs);
+}
+
+// batched inference, for offline evaluation of many positions (see NNUEBatch) :
+// fc0 rows are applied to a whole chunk of positions, each row is thus read once per chunk
+// (the sparse path reads, for each position, only the weights of its own non zero inputs).
+// us and them hold the accumulators of n positions (side to move first), results are the same
+// as one call of simdPropagateFloat/Int per position.
+inline constexpr size_t batchChunk = 16;
+
+template<bool Q, typename WeightsT>
+void simdPropagateFloatBatch(const int16_t* const* us, const int16_t* const* them, const size_t n, const WeightsT& weights, const int bucket, EvalWithUncertainty* out) {
+   constexpr float deqScale = 1.f / Quantization<Q>::scale;
+   const auto&     layer    = weights.innerLayer[bucket];
+   alignas(NNUEALIGNMENT) float x0[batchChunk][2 * firstInnerLayerSize];
+   alignas(NNUEALIGNMENT) float x[batchChunk][32]; // 24 used, keeps each row aligned
+   array1d<int, batchChunk> activeInputs;
+   for (size_t start = 0; start < n; start += batchChunk) {
+      const size_t m = std::min(batchChunk, n - start);
+      for (size_t k = 0; k < m; ++k) {
+         simdDequantizeActivate_i16_f32<firstInnerLayerSize, Q>(x0[k], us[start + k], deqScale);
+         simdDequantizeActivate_i16_f32<firstInnerLayerSize, Q>(x0[k] + firstInnerLayerSize, them[start + k], deqScale);
+      }
+#if defined(WITH_NNUE_SPARSE) && defined(SIMD_AVX2)
+      for (size_t k = 0; k < m; ++k) activeInputs[k] = simdForwardFc0(weights, bucket, x0[k], x[k]);
+#else
+      for (size_t i = 0; i < 8; ++i) {
+         const float* w = layer.fc0.W + i * 2 * firstInnerLayerSize;
+         for (size_t k = 0; k < m; ++k) x[k][i] = layer.fc0.b[i] + simdDotProduct<2 * firstInnerLayerSize, Q>(x0[k], w);
+      }
+      activeInputs.fill(-1);
+#endif
+      for (size_t k = 0; k < m; ++k) {
+         simdActivation<8, Q>(x[k]);
+         out[start + k] = simdPropagateTail<Q>(layer, x[k], activeInputs[k]);
+      }
+   }
+}
+
+template<bool Q, typename WeightsT>
+void simdPropagateIntBatch(const int16_t* const* us, const int16_t* const* them, const size_t n, const WeightsT& weights, const int bucket, EvalWithUncertainty* out) {
+   static_assert(Q, "integer inference needs a quantized accumulator");
+   const auto& layer = weights.innerLayer[bucket];
+   alignas(NNUEALIGNMENT) uint8_t x0[batchChunk][2 * firstInnerLayerSize];
+   alignas(NNUEALIGNMENT) float   x[batchChunk][32]; // 24 used, keeps each row aligned
+   array1d<int, batchChunk> activeInputs;
+   for (size_t start = 0; start < n; start += batchChunk) {
+      const size_t m = std::min(batchChunk, n - start);
+      for (size_t k = 0; k < m; ++k) {
+         simdActivateU8_i16<firstInnerLayerSize>(x0[k], us[start + k]);
+         simdActivateU8_i16<firstInnerLayerSize>(x0[k] + firstInnerLayerSize, them[start + k]);
+      }
+#if defined(WITH_NNUE_SPARSE) && defined(SIMD_AVX2)
+      for (size_t k = 0; k < m; ++k) activeInputs[k] = simdForwardFc0Int8(weights, bucket, x0[k], x[k]);
+#else
+      const auto& fc0 = weights.fc0Int[bucket];
+      for (size_t i = 0; i < 8; ++i) {
+         const int8_t* w = fc0.W + i * 2 * firstInnerLayerSize;
+         for (size_t k = 0; k < m; ++k) x[k][i] = fc0.b[i] + fc0.deqScale[i] * static_cast<float>(simdDotProduct_u8i8<2 * firstInnerLayerSize>(x0[k], w));
+      }
+      activeInputs.fill(-1);
+#endif
+      for (size_t k = 0; k < m; ++k) {
+         simdActivation<8, Q>(x[k]);
+         out[start + k] = simdPropagateTail<Q>(layer, x[k], activeInputs[k]);
+      }
+   }
+}
+
+} // namespace inference
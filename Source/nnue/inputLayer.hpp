@@ -8,9 +8,6 @@
 #include "stackVector.hpp"
 #include "weightReader.hpp"
 
-constexpr size_t inputLayerSize      = FeatureIdx::major * FeatureIdx::minor;
-constexpr size_t firstInnerLayerSize = 384;
-
 template<typename NT, size_t dim0, size_t dim1, bool Q> 
 struct InputLayer {
    static constexpr size_t nbW = dim0 * dim1;
@@ -20,7 +17,9 @@ struct InputLayer {
    using WIT = typename Quantization<Q>::WIT;
 
    // often too big to be statically allocated (see CTOR/DTOR for dynamic alloc)
+   // or pointing directly inside a memory-mapped pre-quantized net (see NNUEWeights::loadMapped)
    typename Quantization<Q>::WIT* W {nullptr};
+   bool mappedW {false};
 
    // bias can be statically allocated 
    alignas(NNUEALIGNMENT) BIT b[nbB];
@@ -35,7 +34,12 @@ struct InputLayer {
       x.sub_(wPtr);
    }
 
+   [[nodiscard]] FORCE_FINLINE const WIT* row(const size_t idx) const {
+      return W + idx * dim1;
+   }
+
    InputLayer<NT, dim0, dim1, Q>& load_(WeightsReader<NT>& ws) {
+      ensureOwned();
       ws.template streamWI<WIT, Q>(W, nbW)
         .template streamBI<BIT, Q>(b, nbB);
       return *this;
@@ -47,12 +51,26 @@ struct InputLayer {
    InputLayer(const InputLayer<NT, dim0, dim1, Q>& other) = delete;
    InputLayer(InputLayer<NT, dim0, dim1, Q>&& other) = delete;
 
+   // use weights owned by someone else (a mapping), they won't be freed here
+   void useMapped(WIT* ptr) {
+      if (!mappedW) ::operator delete(W, NNUEALIGNMENT_STD);
+      W       = ptr;
+      mappedW = true;
+   }
+
+   // get back our own storage (before reading weights into it)
+   void ensureOwned() {
+      if (!mappedW) return;
+      W       = static_cast<WIT*>(operator new[](sizeof(WIT) * nbW, NNUEALIGNMENT_STD));
+      mappedW = false;
+   }
+
    InputLayer() { 
        W = static_cast<WIT*>(operator new[](sizeof(WIT) * nbW, NNUEALIGNMENT_STD));
     }
 
    ~InputLayer() {
-       ::operator delete(W, NNUEALIGNMENT_STD);
+       if (!mappedW) ::operator delete(W, NNUEALIGNMENT_STD);
    }
 };
 
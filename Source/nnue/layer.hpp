@@ -35,14 +35,6 @@ struct Layer {
       return result; // RVO
    }
 
-#ifdef USE_SIMD_INTRIN
-   template<typename T>
-   FORCE_FINLINE void forwardTo(const StackVector<T, dim0, Q>& x, BT* RESTRICT dst) const {
-      for (size_t i = 0; i < dim1; ++i) { dst[i] = b[i]; }
-      for (size_t i = 0; i < dim1; ++i) { dst[i] += x.dot_(W + i * dim0); }
-   }
-#endif
-
    Layer<NT, dim0, dim1, Q>& load_(WeightsReader<NT>& ws) {
       ws.template streamW<WT>(W, nbW, dim0, dim1)
         .template streamB<BT>(b, nbB);
@@ -60,4 +52,52 @@ struct Layer {
 
 };
 
+#ifdef USE_SIMD_INTRIN
+// int8 copy of an inner layer (transposed layout), built from the float one once the net is loaded.
+// Inputs are uint8 activations (see simdActivateU8_i16), each output row has its own weight scale
+// and the int32 result is dequantized back to float (see simdForwardInt8).
+template<size_t dim0, size_t dim1> 
+struct Int8Layer {
+   static constexpr float actScale = 128.f; // activation 1.0 is 128
+
+   alignas(NNUEALIGNMENT) int8_t W[dim0 * dim1];
+   alignas(NNUEALIGNMENT) float  b[dim1];
+   float deqScale[dim1];
+
+   template<typename WT, typename BT> 
+   void quantize(const WT* srcW, const BT* srcB) {
+      for (size_t i = 0; i < dim1; ++i) {
+         const WT* row  = srcW + i * dim0;
+         float     maxW = 0.f;
+         for (size_t j = 0; j < dim0; ++j) maxW = std::max(maxW, std::fabs(static_cast<float>(row[j])));
+         const float wScale = maxW > 0.f ? 127.f / maxW : 1.f;
+         for (size_t j = 0; j < dim0; ++j) W[i * dim0 + j] = static_cast<int8_t>(std::clamp(std::round(static_cast<float>(row[j]) * wScale), -127.f, 127.f));
+         b[i]        = static_cast<float>(srcB[i]);
+         deqScale[i] = 1.f / (wScale * actScale);
+      }
+   }
+};
+
+#ifdef WITH_NNUE_SPARSE
+// input major copies of fc0 for the sparse path (see inference::simdForwardFc0) : the weights of
+// all outputs for one float input, or for one block of 4 uint8 inputs, are contiguous.
+template<size_t dim0, size_t dim1> 
+struct SparseLayer {
+   alignas(NNUEALIGNMENT) float  W[dim0 * dim1];
+   alignas(NNUEALIGNMENT) int8_t W8[dim0 * dim1];
+
+   // from the transposed float layer and its int8 copy
+   template<typename WT> 
+   void build(const WT* srcW, const Int8Layer<dim0, dim1>& srcInt) {
+      for (size_t i = 0; i < dim1; ++i) {
+         for (size_t j = 0; j < dim0; ++j) {
+            W[j * dim1 + i]                          = static_cast<float>(srcW[i * dim0 + j]);
+            W8[(j / 4) * dim1 * 4 + i * 4 + (j % 4)] = srcInt.W[i * dim0 + j];
+         }
+      }
+   }
+};
+#endif // WITH_NNUE_SPARSE
+#endif // USE_SIMD_INTRIN
+
 #endif // WITH_NNUE
\ No newline at end of file
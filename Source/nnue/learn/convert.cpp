@@ -515,7 +515,7 @@ bool rescore(const std::vector<std::string>& filenames, const std::string& outpu
                const Hash matHash = MaterialHash::getMaterialHash(tpos.mat);
                float gp = 1;
                if (matHash != nullHash) {
-                  const MaterialHash::MaterialHashEntry& MEntry = MaterialHash::materialHashTable[matHash];
+                  const MaterialHash::MaterialHashEntry MEntry = MaterialHash::getMaterialEntry(matHash);
                   gp = MEntry.gamePhase();
                }
                // don't worry about "else" here ...
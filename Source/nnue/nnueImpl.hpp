@@ -14,6 +14,13 @@
 #include <string>
 #include <utility>
 
+#ifdef __linux__
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
+
 #ifdef USE_SIMD_INTRIN
 #include "simd.hpp" // manual simd implementations
 #endif
@@ -25,6 +32,8 @@
 #define INCBIN_STYLE INCBIN_STYLE_CAMEL
 #include "incbin.h"
 
+struct NNUERefreshCache; // see nnue.hpp
+
 namespace nnue {
 
 #ifdef EMBEDDEDNNUEPATH
@@ -78,6 +87,13 @@ namespace FeatureIdx {
    
 } // namespace FeatureIdx
 
+constexpr size_t inputLayerSize      = FeatureIdx::major * FeatureIdx::minor;
+constexpr size_t firstInnerLayerSize = 384;
+
+#ifdef WITH_ISA_DISPATCH
+#include "simdDispatch.hpp"
+#endif
+
 #include "evaluator.hpp"
 
 } // namespace nnue
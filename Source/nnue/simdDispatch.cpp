@@ -0,0 +1,84 @@
+#include "nnue.hpp"
+
+#if defined(WITH_NNUE) && defined(WITH_ISA_DISPATCH)
+
+#ifndef USE_SIMD_INTRIN
+#error "ISA dispatch needs USE_SIMD_INTRIN"
+#endif
+
+// The NNUE kernels (simdKernels.hpp and inference.hpp) are compiled here again for each extra target,
+// in their own namespace. The SIMD_* macros tell the kernels what they can use,
+// the target pragmas allow the compiler to emit those instructions for this code only.
+// Selection is done at startup in ISA::init.
+
+#if defined(__clang__)
+#define ISA_TARGET_PUSH(T) _Pragma(T)
+#define ISA_TARGET_POP     _Pragma("clang attribute pop")
+#define ISA_TARGET_AVX2    "clang attribute push(__attribute__((target(\"avx2,fma,bmi,bmi2,popcnt\"))), apply_to = function)"
+#define ISA_TARGET_AVX512  "clang attribute push(__attribute__((target(\"avx512f,avx512bw,avx512vl,avx512dq,avx2,fma,bmi,bmi2,popcnt\"))), apply_to = function)"
+#else
+#define ISA_TARGET_PUSH(T) _Pragma("GCC push_options") _Pragma(T)
+#define ISA_TARGET_POP     _Pragma("GCC pop_options")
+#define ISA_TARGET_AVX2    "GCC target(\"avx2,fma,bmi,bmi2,popcnt\")"
+#define ISA_TARGET_AVX512  "GCC target(\"avx512f,avx512bw,avx512vl,avx512dq,avx2,fma,bmi,bmi2,popcnt\")"
+#endif
+
+namespace nnue {
+
+// build target, kernels from simd.hpp
+namespace isa_generic {
+#define ISA_KERNELS_NAME "generic"
+#include "simdDispatchTable.hpp"
+} // namespace isa_generic
+
+#undef SIMD_SSE2
+#undef SIMD_SSE3
+#undef SIMD_SSSE3
+#undef SIMD_SSE41
+#undef SIMD_FMA
+#undef SIMD_AVX2
+#undef SIMD_AVX512
+#undef SIMD_AVX512VL
+#undef SIMD_AVX512VNNI
+#undef SIMD_AVXVNNI
+
+#define SIMD_SSE2
+#define SIMD_SSE3
+#define SIMD_SSSE3
+#define SIMD_SSE41
+#define SIMD_FMA
+#define SIMD_AVX2
+
+// x86-64-v3 (Haswell, Zen)
+ISA_TARGET_PUSH(ISA_TARGET_AVX2)
+namespace isa_avx2 {
+#include "simdKernels.hpp"
+#include "inference.hpp"
+#define ISA_KERNELS_NAME "avx2"
+#include "simdDispatchTable.hpp"
+} // namespace isa_avx2
+ISA_TARGET_POP
+
+#define SIMD_AVX512
+#define SIMD_AVX512VL
+
+// x86-64-v4 (Skylake-X, Zen 4)
+ISA_TARGET_PUSH(ISA_TARGET_AVX512)
+namespace isa_avx512 {
+#include "simdKernels.hpp"
+#include "inference.hpp"
+#define ISA_KERNELS_NAME "avx512"
+#include "simdDispatchTable.hpp"
+} // namespace isa_avx512
+ISA_TARGET_POP
+
+const ISAKernels isaKernelsGeneric = isa_generic::kernels;
+const ISAKernels isaKernelsAVX2    = isa_avx2::kernels;
+const ISAKernels isaKernelsAVX512  = isa_avx512::kernels;
+
+// generic until ISA::init
+ISAKernels isaKernels = isaKernelsGeneric;
+
+} // namespace nnue
+
+#endif // WITH_NNUE && WITH_ISA_DISPATCH
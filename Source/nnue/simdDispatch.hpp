@@ -0,0 +1,29 @@
+#pragma once
+
+// ISA dispatch builds (WITH_ISA_DISPATCH) compile the NNUE hot paths for several targets,
+// the one matching the running CPU is chosen once at startup (see ISA::init).
+// Note : this is included inside namespace nnue
+
+struct EvalWithUncertainty;
+
+struct ISAKernels {
+   const char* name;
+   // accumulator updates (firstInnerLayerSize values), dst may be src
+   void (*copy)(int16_t* dst, const int16_t* src);
+   void (*add)(int16_t* dst, const int16_t* row);
+   void (*sub)(int16_t* dst, const int16_t* row);
+   void (*addSub)(int16_t* dst, const int16_t* src, const int16_t* add0, const int16_t* sub0);
+   void (*addSubSub)(int16_t* dst, const int16_t* src, const int16_t* add0, const int16_t* sub0, const int16_t* sub1);
+   void (*addAddSubSub)(int16_t* dst, const int16_t* src, const int16_t* add0, const int16_t* add1, const int16_t* sub0, const int16_t* sub1);
+   // inner layers of the engine net, from the accumulators (side to move first)
+   EvalWithUncertainty (*propagate)(const int16_t* us, const int16_t* them, const int bucket);
+   void (*propagateBatch)(const int16_t* const* us, const int16_t* const* them, const size_t n, const int bucket, EvalWithUncertainty* out);
+};
+
+// available targets (see simdDispatch.cpp), generic is the build target itself
+extern const ISAKernels isaKernelsGeneric;
+extern const ISAKernels isaKernelsAVX2;
+extern const ISAKernels isaKernelsAVX512;
+
+// the ones in use
+extern ISAKernels isaKernels;
@@ -0,0 +1,45 @@
+// Entry points of the NNUE kernels for one ISA dispatch target, and their table.
+// There is no include guard on purpose : simdDispatch.cpp includes this once per target,
+// inside the target namespace, right after the kernels of that target.
+
+void copy(int16_t* dst, const int16_t* src) { simdCopy_i16<firstInnerLayerSize>(dst, src); }
+
+void add(int16_t* dst, const int16_t* row) { simdAdd_i16<firstInnerLayerSize>(dst, row); }
+
+void sub(int16_t* dst, const int16_t* row) { simdSub_i16<firstInnerLayerSize>(dst, row); }
+
+void addSub(int16_t* dst, const int16_t* src, const int16_t* add0, const int16_t* sub0) {
+   simdAddSub_i16<firstInnerLayerSize, 1, 1>(dst, src, std::array<const int16_t*, 1>{add0}, std::array<const int16_t*, 1>{sub0});
+}
+
+void addSubSub(int16_t* dst, const int16_t* src, const int16_t* add0, const int16_t* sub0, const int16_t* sub1) {
+   simdAddSub_i16<firstInnerLayerSize, 1, 2>(dst, src, std::array<const int16_t*, 1>{add0}, std::array<const int16_t*, 2>{sub0, sub1});
+}
+
+void addAddSubSub(int16_t* dst, const int16_t* src, const int16_t* add0, const int16_t* add1, const int16_t* sub0, const int16_t* sub1) {
+   simdAddSub_i16<firstInnerLayerSize, 2, 2>(dst, src, std::array<const int16_t*, 2>{add0, add1}, std::array<const int16_t*, 2>{sub0, sub1});
+}
+
+EvalWithUncertainty propagate(const int16_t* us, const int16_t* them, const int bucket) {
+   constexpr bool Q       = NNUEWrapper::quantization;
+   const auto&    weights = NNUEEvaluator::weights;
+#ifdef WITH_NNUE_INT8
+   if constexpr (Q) return inference::simdPropagateInt<Q>(us, them, weights, bucket);
+   else
+#endif
+      return inference::simdPropagateFloat<Q>(us, them, weights, bucket);
+}
+
+void propagateBatch(const int16_t* const* us, const int16_t* const* them, const size_t n, const int bucket, EvalWithUncertainty* out) {
+   constexpr bool Q       = NNUEWrapper::quantization;
+   const auto&    weights = NNUEEvaluator::weights;
+#ifdef WITH_NNUE_INT8
+   inference::simdPropagateIntBatch<Q>(us, them, n, weights, bucket, out);
+#else
+   inference::simdPropagateFloatBatch<Q>(us, them, n, weights, bucket, out);
+#endif
+}
+
+const ISAKernels kernels {ISA_KERNELS_NAME, &copy, &add, &sub, &addSub, &addSubSub, &addAddSubSub, &propagate, &propagateBatch};
+
+#undef ISA_KERNELS_NAME
@@ -0,0 +1,969 @@
+// NNUE SIMD kernels, built for the ISA extensions given by the SIMD_* macros (see simd.hpp).
+// There is no include guard on purpose : ISA dispatch builds include this file again inside
+// a namespace for each extra target (see simdDispatch.cpp), so the macros defined here are reset first.
+
+#undef V_SIMD_512
+#undef V_SIMD_256
+#undef V_SIMD_128
+#undef V_SIMD_MAX
+#undef v_muladd_f32_256
+#undef v_muladd_f32_128
+#undef v_cvtepi16_epi32_128
+
+//----------------------------------
+// AVX512
+//----------------------------------
+#if defined(SIMD_AVX512)
+#define V_SIMD_512 512
+using v_f32_512 = __m512;
+inline constexpr auto v_nlanes_f32_512 = 16;
+#define v_add_f32_512    _mm512_add_ps
+#define v_mul_f32_512    _mm512_mul_ps
+#define v_muladd_f32_512 _mm512_fmadd_ps
+
+FORCE_FINLINE float v_sum_f32_256(__m256 a) {
+   __m256 sum_halves = _mm256_hadd_ps(a, a);
+   sum_halves        = _mm256_hadd_ps(sum_halves, sum_halves);
+   const __m128 lo   = _mm256_castps256_ps128(sum_halves);
+   const __m128 hi   = _mm256_extractf128_ps(sum_halves, 1);
+   const __m128 sum  = _mm_add_ps(lo, hi);
+   return _mm_cvtss_f32(sum);
+}
+
+FORCE_FINLINE float v_sum_f32_512(__m512 a) {
+   return v_sum_f32_256(_mm256_add_ps(_mm512_extractf32x8_ps(a, 0), _mm512_extractf32x8_ps(a, 1)));
+}
+
+// GCC expands some AVX-512 intrinsics (casts to 256 bits included) with an _mm512_undefined_* pass-through operand (-Wuninitialized),
+// their zero-masking forms with a full mask, or an extract of the low half, are used instead. This is the same instruction.
+FORCE_FINLINE __m512  v_max_f32_512(__m512 a, __m512 b) { return _mm512_maskz_max_ps(0xFFFF, a, b); }
+FORCE_FINLINE __m512  v_min_f32_512(__m512 a, __m512 b) { return _mm512_maskz_min_ps(0xFFFF, a, b); }
+FORCE_FINLINE __m512  v_cvtepi32_f32_512(__m512i a) { return _mm512_maskz_cvtepi32_ps(0xFFFF, a); }
+FORCE_FINLINE __m512i v_cvtepi16_epi32_512(__m256i a) { return _mm512_maskz_cvtepi16_epi32(0xFFFF, a); }
+
+#define v_load_f32_512      _mm512_loadu_ps
+#define v_store_f32_512     _mm512_storeu_ps
+#define v_zero_f32_512      _mm512_setzero_ps
+#define v_set_f32_512       _mm512_set1_ps
+
+template<bool Q>
+FORCE_FINLINE void simdClippedReLU512Helper(float * RESTRICT x, const __m512 & zero, const __m512 & un){
+   v_store_f32_512(x, v_max_f32_512(zero, v_min_f32_512(un, v_load_f32_512(x))));
+}
+
+template<size_t N, bool Q>
+void simdActivation512(float * RESTRICT x, const __m512 & zero, const __m512 & un){
+   constexpr int vstep    = v_nlanes_f32_512;
+   constexpr int unrollx4 = N & (-vstep * 4);
+   constexpr int unrollx  = N & -vstep;
+   int i = 0;
+   if constexpr(unrollx4){
+      while (i < unrollx4) {
+            simdClippedReLU512Helper<Q>(x + i            , zero, un);
+            simdClippedReLU512Helper<Q>(x + i + vstep    , zero, un);
+            simdClippedReLU512Helper<Q>(x + i + vstep * 2, zero, un);
+            simdClippedReLU512Helper<Q>(x + i + vstep * 3, zero, un);
+         i += vstep * 4;
+      }
+   }
+   while (i < unrollx) {
+         simdClippedReLU512Helper<Q>(x + i, zero, un);
+      i += vstep;
+   }
+}
+
+template<size_t N, bool Q>
+[[nodiscard]] float simdDotProduct512(const float* RESTRICT x, const float* RESTRICT y) {
+   constexpr int vstep    = v_nlanes_f32_512;
+   constexpr int unrollx4 = N & (-vstep * 4);
+   constexpr int unrollx  = N & -vstep;
+   int i = 0;
+   v_f32_512 vsum0 = v_zero_f32_512();
+   if constexpr(unrollx4){
+      v_f32_512 vsum1 = v_zero_f32_512();
+      v_f32_512 vsum2 = v_zero_f32_512();
+      v_f32_512 vsum3 = v_zero_f32_512();
+      while (i < unrollx4) {
+         vsum0 = v_muladd_f32_512(v_load_f32_512(x + i            ), v_load_f32_512(y + i            ), vsum0);
+         vsum1 = v_muladd_f32_512(v_load_f32_512(x + i + vstep    ), v_load_f32_512(y + i + vstep    ), vsum1);
+         vsum2 = v_muladd_f32_512(v_load_f32_512(x + i + vstep * 2), v_load_f32_512(y + i + vstep * 2), vsum2);
+         vsum3 = v_muladd_f32_512(v_load_f32_512(x + i + vstep * 3), v_load_f32_512(y + i + vstep * 3), vsum3);
+         i += vstep * 4;
+      }
+      vsum0 = v_add_f32_512(v_add_f32_512(vsum0, vsum1), v_add_f32_512(vsum2, vsum3));
+   }
+   while (i < unrollx) {
+      vsum0 = v_muladd_f32_512(v_load_f32_512(x + i), v_load_f32_512(y + i), vsum0);
+      i += vstep;
+   }
+   return v_sum_f32_512(vsum0);
+}
+#endif
+
+//----------------------------------
+// AVX
+//----------------------------------
+#if defined(SIMD_AVX2)
+#define V_SIMD_256 256
+using v_f32_256 = __m256;
+inline constexpr auto v_nlanes_f32_256 = 8;
+#define v_add_f32_256    _mm256_add_ps
+#define v_mul_f32_256    _mm256_mul_ps
+#ifdef SIMD_FMA
+#define v_muladd_f32_256 _mm256_fmadd_ps
+#else
+FORCE_FINLINE __m256 v_muladd_f32_256(__m256 a, __m256 b, __m256 c) { return v_add_f32_256(v_mul_f32_256(a, b), c); }
+#endif
+#ifndef V_SIMD_512
+FORCE_FINLINE float v_sum_f32_256(__m256 a) {
+   __m256 sum_halves = _mm256_hadd_ps(a, a);
+   sum_halves        = _mm256_hadd_ps(sum_halves, sum_halves);
+   const __m128 lo   = _mm256_castps256_ps128(sum_halves);
+   const __m128 hi   = _mm256_extractf128_ps(sum_halves, 1);
+   const __m128 sum  = _mm_add_ps(lo, hi);
+   return _mm_cvtss_f32(sum);
+}
+#endif
+#define v_load_f32_256  _mm256_load_ps
+#define v_store_f32_256 _mm256_store_ps
+#define v_zero_f32_256  _mm256_setzero_ps
+#define v_set_f32_256   _mm256_set1_ps
+#define v_max_f32_256   _mm256_max_ps
+#define v_min_f32_256   _mm256_min_ps
+
+template<bool Q>
+FORCE_FINLINE void simdClippedReLU256Helper(float * RESTRICT x, const __m256 & zero, const __m256 & un){
+   v_store_f32_256(x, v_max_f32_256(zero, v_min_f32_256(un, v_load_f32_256(x))));
+}
+
+template<size_t N, bool Q>
+void simdActivation256(float * RESTRICT x, const __m256 & zero, const __m256 & un){
+   constexpr int vstep    = v_nlanes_f32_256;
+   constexpr int unrollx4 = N & (-vstep * 4);
+   constexpr int unrollx  = N & -vstep;
+   int i = 0;
+   if constexpr(unrollx4){
+      while (i < unrollx4) {
+            simdClippedReLU256Helper<Q>(x + i            , zero, un);
+            simdClippedReLU256Helper<Q>(x + i + vstep    , zero, un);
+            simdClippedReLU256Helper<Q>(x + i + vstep * 2, zero, un);
+            simdClippedReLU256Helper<Q>(x + i + vstep * 3, zero, un);
+         i += vstep * 4;
+      }
+   }
+   while (i < unrollx) {
+         simdClippedReLU256Helper<Q>(x + i, zero, un);
+      i += vstep;
+   }
+}
+
+template<size_t N, bool Q> 
+[[nodiscard]] float simdDotProduct256(const float* RESTRICT x, const float* RESTRICT y) {
+   constexpr int vstep    = v_nlanes_f32_256;
+   constexpr int unrollx4 = N & (-vstep * 4);
+   constexpr int unrollx  = N & -vstep;
+   int i = 0;
+   v_f32_256 vsum0 = v_zero_f32_256();
+   if constexpr(unrollx4){
+      v_f32_256 vsum1 = v_zero_f32_256();
+      v_f32_256 vsum2 = v_zero_f32_256();
+      v_f32_256 vsum3 = v_zero_f32_256();
+      while (i < unrollx4) {
+         vsum0 = v_muladd_f32_256(v_load_f32_256(x + i            ), v_load_f32_256(y + i            ), vsum0);
+         vsum1 = v_muladd_f32_256(v_load_f32_256(x + i + vstep    ), v_load_f32_256(y + i + vstep    ), vsum1);
+         vsum2 = v_muladd_f32_256(v_load_f32_256(x + i + vstep * 2), v_load_f32_256(y + i + vstep * 2), vsum2);
+         vsum3 = v_muladd_f32_256(v_load_f32_256(x + i + vstep * 3), v_load_f32_256(y + i + vstep * 3), vsum3);
+         i += vstep * 4;
+      }
+      vsum0 = v_add_f32_256(v_add_f32_256(vsum0, vsum1), v_add_f32_256(vsum2, vsum3));
+   }
+   while (i < unrollx) {
+      vsum0 = v_muladd_f32_256(v_load_f32_256(x + i), v_load_f32_256(y + i), vsum0);
+      i += vstep;
+   }
+   return v_sum_f32_256(vsum0);
+}
+#endif
+
+//----------------------------------
+// SSE
+//----------------------------------
+#if defined(SIMD_SSE2)
+#define V_SIMD_128 128
+using v_f32_128 = __m128;
+inline constexpr auto v_nlanes_f32_128 = 4;
+#define v_add_f32_128    _mm_add_ps
+#define v_mul_f32_128    _mm_mul_ps
+#ifdef SIMD_FMA
+#define v_muladd_f32_128 _mm_fmadd_ps
+//#elif defined(__FMA4__)
+//#define v_muladd_f32_128 _mm_macc_ps
+#else
+FORCE_FINLINE __m128 v_muladd_f32_128(__m128 a, __m128 b, __m128 c) { return v_add_f32_128(v_mul_f32_128(a, b), c); }
+#endif
+FORCE_FINLINE float v_sum_f32_128(__m128 a) {
+#ifdef SIMD_SSE3
+   const __m128 sum_halves = _mm_hadd_ps(a, a);
+   return _mm_cvtss_f32(_mm_hadd_ps(sum_halves, sum_halves));
+#else
+   const __m128 t1 = _mm_movehl_ps(a, a);
+   const __m128 t2 = _mm_add_ps(a, t1);
+   const __m128 t3 = _mm_shuffle_ps(t2, t2, 1);
+   const __m128 t4 = _mm_add_ss(t2, t3);
+   return _mm_cvtss_f32(t4);
+#endif
+}
+#define v_load_f32_128  _mm_load_ps
+#define v_store_f32_128 _mm_store_ps
+#define v_zero_f32_128  _mm_setzero_ps
+#define v_set_f32_128   _mm_set1_ps
+#define v_max_f32_128   _mm_max_ps
+#define v_min_f32_128   _mm_min_ps
+
+#if defined(SIMD_SSE2)
+#if defined(SIMD_SSE41)
+#define v_cvtepi16_epi32_128 _mm_cvtepi16_epi32
+#else
+FORCE_FINLINE __m128i v_cvtepi16_epi32_128(__m128i src_i16) {
+   const __m128i sign = _mm_srai_epi16(src_i16, 15);
+   return _mm_unpacklo_epi16(src_i16, sign);
+}
+#endif
+#endif
+
+template<bool Q>
+FORCE_FINLINE void simdClippedReLU128Helper(float * RESTRICT x, const v_f32_128 & zero, const v_f32_128 & un){
+   v_store_f32_128(x, v_max_f32_128(zero, v_min_f32_128(un, v_load_f32_128(x))));
+}
+
+
+template<size_t N, bool Q>
+void simdActivation128(float * RESTRICT x, const v_f32_128 & zero, const v_f32_128 & un){
+   constexpr int vstep    = v_nlanes_f32_128;
+   constexpr int unrollx4 = N & (-vstep * 4);
+   constexpr int unrollx  = N & -vstep;   
+   int i = 0;
+   if constexpr(unrollx4){
+      while (i < unrollx4) {
+            simdClippedReLU128Helper<Q>(x + i            , zero, un);
+            simdClippedReLU128Helper<Q>(x + i + vstep    , zero, un);
+            simdClippedReLU128Helper<Q>(x + i + vstep * 2, zero, un);
+            simdClippedReLU128Helper<Q>(x + i + vstep * 3, zero, un);
+         i += vstep * 4;
+      }
+   }
+   while (i < unrollx) {
+         simdClippedReLU128Helper<Q>(x + i, zero, un);
+      i += vstep;
+   }
+}
+
+template<size_t N, bool Q> 
+[[nodiscard]] float simdDotProduct128(const float* RESTRICT x, const float* RESTRICT y) {
+   constexpr int vstep    = v_nlanes_f32_128;
+   constexpr int unrollx4 = N & (-vstep * 4);
+   constexpr int unrollx  = N & -vstep;
+   int i = 0;
+   v_f32_128 vsum0 = v_zero_f32_128();
+   if constexpr(unrollx4){
+      v_f32_128 vsum1 = v_zero_f32_128();
+      v_f32_128 vsum2 = v_zero_f32_128();
+      v_f32_128 vsum3 = v_zero_f32_128();
+      while (i < unrollx4) {
+         vsum0 = v_muladd_f32_128(v_load_f32_128(x + i            ), v_load_f32_128(y + i            ), vsum0);
+         vsum1 = v_muladd_f32_128(v_load_f32_128(x + i + vstep    ), v_load_f32_128(y + i + vstep    ), vsum1);
+         vsum2 = v_muladd_f32_128(v_load_f32_128(x + i + vstep * 2), v_load_f32_128(y + i + vstep * 2), vsum2);
+         vsum3 = v_muladd_f32_128(v_load_f32_128(x + i + vstep * 3), v_load_f32_128(y + i + vstep * 3), vsum3);
+         i += vstep * 4;
+      }
+      vsum0 = v_add_f32_128(v_add_f32_128(vsum0, vsum1), v_add_f32_128(vsum2, vsum3));
+   }
+   while (i < unrollx) {
+      vsum0 = v_muladd_f32_128(v_load_f32_128(x + i), v_load_f32_128(y + i), vsum0);
+      i += vstep;
+   }
+   return v_sum_f32_128(vsum0);
+}
+
+#endif
+
+// widest vector size available, kernels below can be asked to stay under a given width
+// (mainly for validation of a wider path against a narrower one, see -simd_test)
+#if defined(V_SIMD_512)
+#define V_SIMD_MAX 512
+#elif defined(V_SIMD_256)
+#define V_SIMD_MAX 256
+#elif defined(V_SIMD_128)
+#define V_SIMD_MAX 128
+#else
+#define V_SIMD_MAX 0
+#endif
+
+template<size_t N, bool Q> 
+FORCE_FINLINE void simdActivationDefault(float * RESTRICT x){
+   constexpr int n1 = N & -4;
+   for (int i = 0; i < n1; i += 4) {
+         x[i]     = std::min(std::max(x[i]    , 0.f), 1.f);
+         x[i + 1] = std::min(std::max(x[i + 1], 0.f), 1.f);
+         x[i + 2] = std::min(std::max(x[i + 2], 0.f), 1.f);
+         x[i + 3] = std::min(std::max(x[i + 3], 0.f), 1.f);
+   }   
+}
+
+template<size_t N, bool Q> 
+[[nodiscard]] float simdDotProductDefault(const float* RESTRICT x, const float* RESTRICT y) {
+   constexpr int n1 = N & -4;
+   float dot = 0.f;
+   for (int i = 0; i < n1; i += 4) { 
+      dot += y[i    ] * x[i    ]
+           + y[i + 1] * x[i + 1] 
+           + y[i + 2] * x[i + 2] 
+           + y[i + 3] * x[i + 3]; 
+   }
+   return dot;
+}
+
+template<size_t N, size_t W = V_SIMD_MAX>
+FORCE_FINLINE void simdAdd_i16(int16_t* RESTRICT dst, const int16_t* RESTRICT src) {
+   size_t i = 0;
+#if V_SIMD_512
+   if constexpr (W >= 512) {
+      constexpr size_t vstep512 = 32;
+      while (i + vstep512 <= N) {
+         _mm512_storeu_si512(dst + i, _mm512_add_epi16(_mm512_loadu_si512(dst + i), _mm512_loadu_si512(src + i)));
+         i += vstep512;
+      }
+   }
+#endif
+#if V_SIMD_256
+   if constexpr (W >= 256) {
+      constexpr size_t vstep = 16; // 256 bits / 16 bits
+      constexpr size_t unrollx4 = N & (-vstep * 4);
+      constexpr size_t unrollx  = N & -vstep;
+      if constexpr (unrollx4) {
+         while (i + vstep * 4 <= unrollx4) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i            ), _mm256_add_epi16(_mm256_load_si256(reinterpret_cast<const __m256i*>(dst + i            )), _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i            ))));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i + vstep    ), _mm256_add_epi16(_mm256_load_si256(reinterpret_cast<const __m256i*>(dst + i + vstep    )), _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i + vstep    ))));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i + vstep * 2), _mm256_add_epi16(_mm256_load_si256(reinterpret_cast<const __m256i*>(dst + i + vstep * 2)), _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i + vstep * 2))));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i + vstep * 3), _mm256_add_epi16(_mm256_load_si256(reinterpret_cast<const __m256i*>(dst + i + vstep * 3)), _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i + vstep * 3))));
+            i += vstep * 4;
+         }
+      }
+      while (i + vstep <= unrollx) {
+         _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_add_epi16(_mm256_load_si256(reinterpret_cast<const __m256i*>(dst + i)), _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i))));
+         i += vstep;
+      }
+   }
+#endif
+#if V_SIMD_128
+   if constexpr (W >= 128) {
+      constexpr size_t vstep128 = 8;
+      while (i + vstep128 <= N) {
+         _mm_store_si128(reinterpret_cast<__m128i*>(dst + i), _mm_add_epi16(_mm_load_si128(reinterpret_cast<const __m128i*>(dst + i)), _mm_load_si128(reinterpret_cast<const __m128i*>(src + i))));
+         i += vstep128;
+      }
+   }
+#endif
+   const size_t tail = N - i;
+   for (size_t j = 0; j < tail; ++j) dst[i + j] += src[i + j];
+}
+
+template<size_t N, size_t W = V_SIMD_MAX>
+FORCE_FINLINE void simdSub_i16(int16_t* RESTRICT dst, const int16_t* RESTRICT src) {
+   size_t i = 0;
+#if V_SIMD_512
+   if constexpr (W >= 512) {
+      constexpr size_t vstep512 = 32;
+      while (i + vstep512 <= N) {
+         _mm512_storeu_si512(dst + i, _mm512_sub_epi16(_mm512_loadu_si512(dst + i), _mm512_loadu_si512(src + i)));
+         i += vstep512;
+      }
+   }
+#endif
+#if V_SIMD_256
+   if constexpr (W >= 256) {
+      constexpr size_t vstep = 16;
+      constexpr size_t unrollx4 = N & (-vstep * 4);
+      constexpr size_t unrollx  = N & -vstep;
+      if constexpr (unrollx4) {
+         while (i + vstep * 4 <= unrollx4) {
+            _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i            ), _mm256_sub_epi16(_mm256_load_si256(reinterpret_cast<const __m256i*>(dst + i            )), _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i            ))));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i + vstep    ), _mm256_sub_epi16(_mm256_load_si256(reinterpret_cast<const __m256i*>(dst + i + vstep    )), _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i + vstep    ))));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i + vstep * 2), _mm256_sub_epi16(_mm256_load_si256(reinterpret_cast<const __m256i*>(dst + i + vstep * 2)), _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i + vstep * 2))));
+            _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i + vstep * 3), _mm256_sub_epi16(_mm256_load_si256(reinterpret_cast<const __m256i*>(dst + i + vstep * 3)), _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i + vstep * 3))));
+            i += vstep * 4;
+         }
+      }
+      while (i + vstep <= unrollx) {
+         _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_sub_epi16(_mm256_load_si256(reinterpret_cast<const __m256i*>(dst + i)), _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i))));
+         i += vstep;
+      }
+   }
+#endif
+#if V_SIMD_128
+   if constexpr (W >= 128) {
+      constexpr size_t vstep128 = 8;
+      while (i + vstep128 <= N) {
+         _mm_store_si128(reinterpret_cast<__m128i*>(dst + i), _mm_sub_epi16(_mm_load_si128(reinterpret_cast<const __m128i*>(dst + i)), _mm_load_si128(reinterpret_cast<const __m128i*>(src + i))));
+         i += vstep128;
+      }
+   }
+#endif
+   const size_t tail = N - i;
+   for (size_t j = 0; j < tail; ++j) dst[i + j] -= src[i + j];
+}
+
+template<size_t N, size_t W = V_SIMD_MAX>
+FORCE_FINLINE void simdCopy_i16(int16_t* RESTRICT dst, const int16_t* RESTRICT src) {
+   size_t i = 0;
+#if V_SIMD_512
+   if constexpr (W >= 512) {
+      constexpr size_t vstep512 = 32;
+      while (i + vstep512 <= N) {
+         _mm512_storeu_si512(dst + i, _mm512_loadu_si512(src + i));
+         i += vstep512;
+      }
+   }
+#endif
+#if V_SIMD_256
+   if constexpr (W >= 256) {
+      constexpr size_t vstep = 16;
+      while (i + vstep <= N) {
+         _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i)));
+         i += vstep;
+      }
+   }
+#endif
+#if V_SIMD_128
+   if constexpr (W >= 128) {
+      constexpr size_t vstep128 = 8;
+      while (i + vstep128 <= N) {
+         _mm_store_si128(reinterpret_cast<__m128i*>(dst + i), _mm_load_si128(reinterpret_cast<const __m128i*>(src + i)));
+         i += vstep128;
+      }
+   }
+#endif
+   const size_t tail = N - i;
+   if (tail) std::memcpy(dst + i, src + i, tail * sizeof(int16_t));
+}
+
+// fused accumulator update : dst = src - subs + adds in a single pass (the accumulator is loaded and stored only once)
+// dst and src may be the same vector (in-place update), so they are not RESTRICT
+template<size_t N, size_t NA, size_t NS, size_t W = V_SIMD_MAX>
+FORCE_FINLINE void simdAddSub_i16(int16_t* dst, const int16_t* src, const std::array<const int16_t*, NA>& adds, const std::array<const int16_t*, NS>& subs) {
+   size_t i = 0;
+#if V_SIMD_512
+   if constexpr (W >= 512) {
+      constexpr size_t vstep512 = 32;
+      while (i + vstep512 <= N) {
+         __m512i acc = _mm512_loadu_si512(src + i);
+         for (size_t k = 0; k < NS; ++k) acc = _mm512_sub_epi16(acc, _mm512_loadu_si512(subs[k] + i));
+         for (size_t k = 0; k < NA; ++k) acc = _mm512_add_epi16(acc, _mm512_loadu_si512(adds[k] + i));
+         _mm512_storeu_si512(dst + i, acc);
+         i += vstep512;
+      }
+   }
+#endif
+#if V_SIMD_256
+   if constexpr (W >= 256) {
+      constexpr size_t vstep = 16;
+      while (i + vstep <= N) {
+         __m256i acc = _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i));
+         for (size_t k = 0; k < NS; ++k) acc = _mm256_sub_epi16(acc, _mm256_load_si256(reinterpret_cast<const __m256i*>(subs[k] + i)));
+         for (size_t k = 0; k < NA; ++k) acc = _mm256_add_epi16(acc, _mm256_load_si256(reinterpret_cast<const __m256i*>(adds[k] + i)));
+         _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i), acc);
+         i += vstep;
+      }
+   }
+#endif
+#if V_SIMD_128
+   if constexpr (W >= 128) {
+      constexpr size_t vstep128 = 8;
+      while (i + vstep128 <= N) {
+         __m128i acc = _mm_load_si128(reinterpret_cast<const __m128i*>(src + i));
+         for (size_t k = 0; k < NS; ++k) acc = _mm_sub_epi16(acc, _mm_load_si128(reinterpret_cast<const __m128i*>(subs[k] + i)));
+         for (size_t k = 0; k < NA; ++k) acc = _mm_add_epi16(acc, _mm_load_si128(reinterpret_cast<const __m128i*>(adds[k] + i)));
+         _mm_store_si128(reinterpret_cast<__m128i*>(dst + i), acc);
+         i += vstep128;
+      }
+   }
+#endif
+   // the accumulator width is a multiple of the smallest vector step, the scalar loop is only for non SIMD builds
+#if V_SIMD_128
+   constexpr size_t minStep = W >= 128 ? 8 : 1;
+#else
+   constexpr size_t minStep = 1;
+#endif
+   if constexpr (minStep == 1 || N % minStep != 0) {
+      for (; i < N; ++i) {
+         int16_t acc = src[i];
+         for (size_t k = 0; k < NS; ++k) acc -= subs[k][i];
+         for (size_t k = 0; k < NA; ++k) acc += adds[k][i];
+         dst[i] = acc;
+      }
+   }
+}
+
+template<size_t N, size_t W = V_SIMD_MAX>
+FORCE_FINLINE void simdCopy_f32(float* RESTRICT dst, const float* RESTRICT src) {
+   size_t i = 0;
+#if V_SIMD_512
+   if constexpr (W >= 512) {
+      constexpr size_t vstep512 = 16;
+      while (i + vstep512 <= N) {
+         _mm512_storeu_ps(dst + i, _mm512_loadu_ps(src + i));
+         i += vstep512;
+      }
+   }
+#endif
+#if V_SIMD_256
+   if constexpr (W >= 256) {
+      constexpr size_t vstep = 8;
+      while (i + vstep <= N) {
+         _mm256_store_ps(dst + i, _mm256_load_ps(src + i));
+         i += vstep;
+      }
+   }
+#endif
+#if V_SIMD_128
+   if constexpr (W >= 128) {
+      constexpr size_t vstep128 = 4;
+      while (i + vstep128 <= N) {
+         _mm_store_ps(dst + i, _mm_load_ps(src + i));
+         i += vstep128;
+      }
+   }
+#endif
+   const size_t tail = N - i;
+   if (tail) std::memcpy(dst + i, src + i, tail * sizeof(float));
+}
+
+template<size_t N, size_t W = V_SIMD_MAX>
+FORCE_FINLINE void simdDequantize_i16_f32(float* RESTRICT dst, const int16_t* RESTRICT src, const float scale) {
+   size_t i = 0;
+#if V_SIMD_512
+   if constexpr (W >= 512) {
+      constexpr size_t vstep512 = 16;
+      const __m512 vscale512 = _mm512_set1_ps(scale);
+      while (i + vstep512 <= N) {
+         const __m512i src_i32 = v_cvtepi16_epi32_512(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+         _mm512_storeu_ps(dst + i, _mm512_mul_ps(v_cvtepi32_f32_512(src_i32), vscale512));
+         i += vstep512;
+      }
+   }
+#endif
+#if V_SIMD_256
+   if constexpr (W >= 256) {
+      constexpr size_t vstep = 8; // 8 floats per __m256
+      const __m256 vscale = _mm256_set1_ps(scale);
+      while (i + vstep <= N) {
+         // Load 8 x int16, sign-extend to 8 x int32, convert to 8 x float, multiply by scale
+         const __m128i src_i16 = _mm_load_si128(reinterpret_cast<const __m128i*>(src + i));
+         const __m256i src_i32 = _mm256_cvtepi16_epi32(src_i16);
+         const __m256  src_f32 = _mm256_cvtepi32_ps(src_i32);
+         _mm256_store_ps(dst + i, _mm256_mul_ps(src_f32, vscale));
+         i += vstep;
+      }
+   }
+#endif
+#if V_SIMD_128
+   if constexpr (W >= 128) {
+      constexpr size_t vstep128 = 4;
+      const __m128 vscale128 = _mm_set1_ps(scale);
+      while (i + vstep128 <= N) {
+         // Load 4 x int16 (as 64-bit), sign-extend to 4 x int32, convert to 4 x float
+         const __m128i src_i16 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+         const __m128i src_i32 = v_cvtepi16_epi32_128(src_i16);
+         const __m128  src_f32 = _mm_cvtepi32_ps(src_i32);
+         _mm_store_ps(dst + i, _mm_mul_ps(src_f32, vscale128));
+         i += vstep128;
+      }
+   }
+#endif
+   const size_t tail = N - i;
+   for (size_t j = 0; j < tail; ++j) dst[i + j] = scale * static_cast<float>(src[i + j]);
+}
+
+template<size_t N0, size_t N1>
+FORCE_FINLINE void simdSplice_f32(float* RESTRICT dst, const float* RESTRICT a, const float* RESTRICT b) {
+   simdCopy_f32<N0>(dst, a);
+   simdCopy_f32<N1>(dst + N0, b);
+}
+
+template<size_t N, bool Q, size_t W = V_SIMD_MAX>
+FORCE_FINLINE void simdDequantizeActivate_i16_f32(float* RESTRICT dst, const int16_t* RESTRICT src, const float scale) {
+   size_t i = 0;
+#if V_SIMD_512
+   if constexpr (W >= 512) {
+      constexpr size_t vstep512 = 16;
+      const __m512 vscale512 = _mm512_set1_ps(scale);
+      const __m512 vzero512  = _mm512_setzero_ps();
+      const __m512 vone512   = _mm512_set1_ps(1.0f);
+      while (i + vstep512 <= N) {
+         const __m512i src_i32 = v_cvtepi16_epi32_512(_mm256_loadu_si256(reinterpret_cast<const __m256i*>(src + i)));
+         const __m512  deq     = _mm512_mul_ps(v_cvtepi32_f32_512(src_i32), vscale512);
+         _mm512_storeu_ps(dst + i, v_max_f32_512(vzero512, v_min_f32_512(vone512, deq)));
+         i += vstep512;
+      }
+   }
+#endif
+#if V_SIMD_256
+   if constexpr (W >= 256) {
+      constexpr size_t vstep = 8;
+      const __m256 vscale = _mm256_set1_ps(scale);
+      const __m256 vzero  = _mm256_setzero_ps();
+      const __m256 vone   = _mm256_set1_ps(1.0f);
+      while (i + vstep <= N) {
+         const __m128i src_i16 = _mm_load_si128(reinterpret_cast<const __m128i*>(src + i));
+         const __m256i src_i32 = _mm256_cvtepi16_epi32(src_i16);
+         const __m256  deq     = _mm256_mul_ps(_mm256_cvtepi32_ps(src_i32), vscale);
+         _mm256_store_ps(dst + i, _mm256_max_ps(vzero, _mm256_min_ps(vone, deq)));
+         i += vstep;
+      }
+   }
+#endif
+#if V_SIMD_128
+   if constexpr (W >= 128) {
+      constexpr size_t vstep128 = 4;
+      const __m128 vscale128 = _mm_set1_ps(scale);
+      const __m128 vzero128  = _mm_setzero_ps();
+      const __m128 vone128   = _mm_set1_ps(1.0f);
+      while (i + vstep128 <= N) {
+         const __m128i src_i16 = _mm_loadl_epi64(reinterpret_cast<const __m128i*>(src + i));
+         const __m128i src_i32 = v_cvtepi16_epi32_128(src_i16);
+         const __m128  deq     = _mm_mul_ps(_mm_cvtepi32_ps(src_i32), vscale128);
+         _mm_store_ps(dst + i, _mm_max_ps(vzero128, _mm_min_ps(vone128, deq)));
+         i += vstep128;
+      }
+   }
+#endif
+   const size_t tail = N - i;
+   for (size_t j = 0; j < tail; ++j) {
+      const float deq = scale * static_cast<float>(src[i + j]);
+      dst[i + j] = std::max(0.f, std::min(1.f, deq));
+   }
+}
+
+// integer inference path (see NNUEEval::propagateInt)
+// clipped activation of the int16 accumulator (scale 512) to uint8 in [0, 127] (scale 128)
+template<size_t N, size_t W = V_SIMD_MAX>
+FORCE_FINLINE void simdActivateU8_i16(uint8_t* RESTRICT dst, const int16_t* RESTRICT src) {
+   size_t i = 0;
+#if V_SIMD_512
+   if constexpr (W >= 512) {
+      constexpr size_t vstep512 = 64;
+      const __m512i vzero512 = _mm512_setzero_si512();
+      const __m512i vmax512  = _mm512_set1_epi16(511);
+      // packus works on 128 bits lanes, restore natural order
+      const __m512i order    = _mm512_setr_epi64(0, 2, 4, 6, 1, 3, 5, 7);
+      while (i + vstep512 <= N) {
+         const __m512i a = _mm512_srai_epi16(_mm512_min_epi16(vmax512, _mm512_max_epi16(vzero512, _mm512_loadu_si512(src + i))), 2);
+         const __m512i b = _mm512_srai_epi16(_mm512_min_epi16(vmax512, _mm512_max_epi16(vzero512, _mm512_loadu_si512(src + i + 32))), 2);
+         _mm512_storeu_si512(dst + i, _mm512_maskz_permutexvar_epi64(0xFF, order, _mm512_packus_epi16(a, b)));
+         i += vstep512;
+      }
+   }
+#endif
+#if V_SIMD_256
+   if constexpr (W >= 256) {
+      constexpr size_t vstep = 32; // two int16 vectors packed into one uint8 vector
+      const __m256i vzero = _mm256_setzero_si256();
+      const __m256i vmax  = _mm256_set1_epi16(511);
+      while (i + vstep <= N) {
+         const __m256i a = _mm256_srai_epi16(_mm256_min_epi16(vmax, _mm256_max_epi16(vzero, _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i)))), 2);
+         const __m256i b = _mm256_srai_epi16(_mm256_min_epi16(vmax, _mm256_max_epi16(vzero, _mm256_load_si256(reinterpret_cast<const __m256i*>(src + i + 16)))), 2);
+         // packus works on 128 bits lanes, restore natural order
+         _mm256_store_si256(reinterpret_cast<__m256i*>(dst + i), _mm256_permute4x64_epi64(_mm256_packus_epi16(a, b), 0xD8));
+         i += vstep;
+      }
+   }
+#endif
+#if V_SIMD_128
+   if constexpr (W >= 128) {
+      constexpr size_t vstep128 = 16;
+      const __m128i vzero128 = _mm_setzero_si128();
+      const __m128i vmax128  = _mm_set1_epi16(511);
+      while (i + vstep128 <= N) {
+         const __m128i a = _mm_srai_epi16(_mm_min_epi16(vmax128, _mm_max_epi16(vzero128, _mm_load_si128(reinterpret_cast<const __m128i*>(src + i)))), 2);
+         const __m128i b = _mm_srai_epi16(_mm_min_epi16(vmax128, _mm_max_epi16(vzero128, _mm_load_si128(reinterpret_cast<const __m128i*>(src + i + 8)))), 2);
+         _mm_store_si128(reinterpret_cast<__m128i*>(dst + i), _mm_packus_epi16(a, b));
+         i += vstep128;
+      }
+   }
+#endif
+   // same as in simdAddSub_i16, the scalar loop is only for non SIMD builds or a width that is not a multiple of the vector step
+#if V_SIMD_128
+   constexpr size_t minStep = W >= 128 ? 16 : 1;
+#else
+   constexpr size_t minStep = 1;
+#endif
+   if constexpr (minStep == 1 || N % minStep != 0) {
+      for (; i < N; ++i) dst[i] = static_cast<uint8_t>(std::clamp<int>(src[i], 0, 511) >> 2);
+   }
+}
+
+// uint8 (< 128) by int8 dot product with int32 accumulation
+// maddubs cannot saturate here as 2 * 127 * 127 < 32767
+template<size_t N, size_t W = V_SIMD_MAX>
+[[nodiscard]] FORCE_FINLINE int32_t simdDotProduct_u8i8(const uint8_t* RESTRICT x, const int8_t* RESTRICT w) {
+   size_t  i   = 0;
+   int32_t sum = 0;
+#if V_SIMD_512
+   if constexpr (W >= 512) {
+      constexpr size_t vstep512 = 64;
+      __m512i acc512 = _mm512_setzero_si512();
+#ifndef SIMD_AVX512VNNI
+      const __m512i ones512 = _mm512_set1_epi16(1);
+#endif
+      while (i + vstep512 <= N) {
+         const __m512i vx = _mm512_loadu_si512(x + i);
+         const __m512i vw = _mm512_loadu_si512(w + i);
+#ifdef SIMD_AVX512VNNI
+         acc512 = _mm512_dpbusd_epi32(acc512, vx, vw);
+#else
+         acc512 = _mm512_add_epi32(acc512, _mm512_madd_epi16(_mm512_maddubs_epi16(vx, vw), ones512));
+#endif
+         i += vstep512;
+      }
+      const __m256i acc256 = _mm256_add_epi32(_mm512_extracti32x8_epi32(acc512, 0), _mm512_extracti32x8_epi32(acc512, 1));
+      __m128i       acc128 = _mm_add_epi32(_mm256_castsi256_si128(acc256), _mm256_extracti128_si256(acc256, 1));
+      acc128 = _mm_add_epi32(acc128, _mm_shuffle_epi32(acc128, 0x4E));
+      acc128 = _mm_add_epi32(acc128, _mm_shuffle_epi32(acc128, 0xB1));
+      sum += _mm_cvtsi128_si32(acc128);
+   }
+#endif
+#if V_SIMD_256
+   if constexpr (W >= 256) {
+      constexpr size_t vstep = 32;
+      __m256i acc = _mm256_setzero_si256();
+#if !defined(SIMD_AVXVNNI) && !(defined(SIMD_AVX512VNNI) && defined(SIMD_AVX512VL))
+      const __m256i ones = _mm256_set1_epi16(1);
+#endif
+      while (i + vstep <= N) {
+         const __m256i vx = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+         const __m256i vw = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(w + i));
+#if defined(SIMD_AVX512VNNI) && defined(SIMD_AVX512VL)
+         acc = _mm256_dpbusd_epi32(acc, vx, vw);
+#elif defined(SIMD_AVXVNNI)
+         acc = _mm256_dpbusd_avx_epi32(acc, vx, vw);
+#else
+         acc = _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_maddubs_epi16(vx, vw), ones));
+#endif
+         i += vstep;
+      }
+      __m128i acc128 = _mm_add_epi32(_mm256_castsi256_si128(acc), _mm256_extracti128_si256(acc, 1));
+      acc128 = _mm_add_epi32(acc128, _mm_shuffle_epi32(acc128, 0x4E));
+      acc128 = _mm_add_epi32(acc128, _mm_shuffle_epi32(acc128, 0xB1));
+      sum += _mm_cvtsi128_si32(acc128);
+   }
+#endif
+#if defined(SIMD_SSSE3)
+   if constexpr (W >= 128) {
+      constexpr size_t vstep128 = 16;
+      __m128i acc128 = _mm_setzero_si128();
+      const __m128i ones128 = _mm_set1_epi16(1);
+      while (i + vstep128 <= N) {
+         const __m128i vx = _mm_loadu_si128(reinterpret_cast<const __m128i*>(x + i));
+         const __m128i vw = _mm_loadu_si128(reinterpret_cast<const __m128i*>(w + i));
+         acc128 = _mm_add_epi32(acc128, _mm_madd_epi16(_mm_maddubs_epi16(vx, vw), ones128));
+         i += vstep128;
+      }
+      acc128 = _mm_add_epi32(acc128, _mm_shuffle_epi32(acc128, 0x4E));
+      acc128 = _mm_add_epi32(acc128, _mm_shuffle_epi32(acc128, 0xB1));
+      sum += _mm_cvtsi128_si32(acc128);
+   }
+#endif
+   for (; i < N; ++i) sum += static_cast<int32_t>(x[i]) * static_cast<int32_t>(w[i]);
+   return sum;
+}
+
+#if V_SIMD_256
+// sparse path of the first inner layer (see inference::simdForwardFc0)
+// indices of the non zero inputs, N must be a multiple of 8
+template<size_t N>
+[[nodiscard]] FORCE_FINLINE size_t simdNonZero_f32(const float* RESTRICT x, uint16_t* RESTRICT nnz) {
+   static_assert(N % 8 == 0, "non zero scan works on whole vectors");
+   size_t count = 0;
+   size_t i     = 0;
+#if V_SIMD_512
+   const __m512 vzero512 = _mm512_setzero_ps();
+   for (; i + 16 <= N; i += 16) {
+      unsigned int mask = _mm512_cmp_ps_mask(_mm512_loadu_ps(x + i), vzero512, _CMP_NEQ_OQ);
+      while (mask) {
+         nnz[count++] = static_cast<uint16_t>(i + std::countr_zero(mask));
+         mask &= mask - 1;
+      }
+   }
+#endif
+   const __m256 vzero = _mm256_setzero_ps();
+   for (; i < N; i += 8) {
+      unsigned int mask = static_cast<unsigned int>(_mm256_movemask_ps(_mm256_cmp_ps(_mm256_loadu_ps(x + i), vzero, _CMP_NEQ_OQ)));
+      while (mask) {
+         nnz[count++] = static_cast<uint16_t>(i + std::countr_zero(mask));
+         mask &= mask - 1;
+      }
+   }
+   return count;
+}
+
+// indices of the non zero blocks of 4 uint8 inputs, N must be a multiple of 32
+template<size_t N>
+[[nodiscard]] FORCE_FINLINE size_t simdNonZero_u8x4(const uint8_t* RESTRICT x, uint16_t* RESTRICT nnz) {
+   static_assert(N % 32 == 0, "non zero scan works on whole vectors");
+   size_t count = 0;
+   size_t i     = 0;
+#if V_SIMD_512
+   for (; i + 64 <= N; i += 64) {
+      const __m512i v    = _mm512_loadu_si512(x + i);
+      unsigned int  mask = _mm512_test_epi32_mask(v, v);
+      while (mask) {
+         nnz[count++] = static_cast<uint16_t>(i / 4 + std::countr_zero(mask));
+         mask &= mask - 1;
+      }
+   }
+#endif
+   const __m256i vzero = _mm256_setzero_si256();
+   for (; i < N; i += 32) {
+      const __m256i v    = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(x + i));
+      unsigned int  mask = ~static_cast<unsigned int>(_mm256_movemask_ps(_mm256_castsi256_ps(_mm256_cmpeq_epi32(v, vzero)))) & 0xFF;
+      while (mask) {
+         nnz[count++] = static_cast<uint16_t>(i / 4 + std::countr_zero(mask));
+         mask &= mask - 1;
+      }
+   }
+   return count;
+}
+
+// dst = b + sum of x[j] * W[j] over the given inputs, W is input major (8 outputs per input)
+FORCE_FINLINE void simdSparseAffine8_f32(const float* RESTRICT x, const uint16_t* RESTRICT nnz, const size_t count, const float* RESTRICT W, const float* RESTRICT b, float* RESTRICT dst) {
+   // several accumulators to hide the fma latency
+   __m256 acc0 = _mm256_loadu_ps(b);
+   __m256 acc1 = _mm256_setzero_ps();
+   __m256 acc2 = _mm256_setzero_ps();
+   __m256 acc3 = _mm256_setzero_ps();
+   size_t k    = 0;
+   for (; k + 4 <= count; k += 4) {
+      acc0 = v_muladd_f32_256(_mm256_set1_ps(x[nnz[k    ]]), _mm256_load_ps(W + nnz[k    ] * 8), acc0);
+      acc1 = v_muladd_f32_256(_mm256_set1_ps(x[nnz[k + 1]]), _mm256_load_ps(W + nnz[k + 1] * 8), acc1);
+      acc2 = v_muladd_f32_256(_mm256_set1_ps(x[nnz[k + 2]]), _mm256_load_ps(W + nnz[k + 2] * 8), acc2);
+      acc3 = v_muladd_f32_256(_mm256_set1_ps(x[nnz[k + 3]]), _mm256_load_ps(W + nnz[k + 3] * 8), acc3);
+   }
+   for (; k < count; ++k) acc0 = v_muladd_f32_256(_mm256_set1_ps(x[nnz[k]]), _mm256_load_ps(W + nnz[k] * 8), acc0);
+   _mm256_storeu_ps(dst, _mm256_add_ps(_mm256_add_ps(acc0, acc1), _mm256_add_ps(acc2, acc3)));
+}
+
+// dst = sum of x block j by W block j over the given blocks of 4 uint8 inputs,
+// W is block major : for each block, the 4 int8 weights of each of the 8 outputs (int32 lane i is output i)
+FORCE_FINLINE void simdSparseAffine8_u8i8(const uint8_t* RESTRICT x, const uint16_t* RESTRICT nnz, const size_t count, const int8_t* RESTRICT W, int32_t* RESTRICT dst) {
+   __m256i acc = _mm256_setzero_si256();
+#if !defined(SIMD_AVXVNNI) && !(defined(SIMD_AVX512VNNI) && defined(SIMD_AVX512VL))
+   const __m256i ones = _mm256_set1_epi16(1);
+#endif
+   for (size_t k = 0; k < count; ++k) {
+      int32_t block;
+      std::memcpy(&block, x + nnz[k] * 4, sizeof(int32_t));
+      const __m256i vx = _mm256_set1_epi32(block);
+      const __m256i vw = _mm256_load_si256(reinterpret_cast<const __m256i*>(W + nnz[k] * 32));
+#if defined(SIMD_AVX512VNNI) && defined(SIMD_AVX512VL)
+      acc = _mm256_dpbusd_epi32(acc, vx, vw);
+#elif defined(SIMD_AVXVNNI)
+      acc = _mm256_dpbusd_avx_epi32(acc, vx, vw);
+#else
+      acc = _mm256_add_epi32(acc, _mm256_madd_epi16(_mm256_maddubs_epi16(vx, vw), ones));
+#endif
+   }
+   _mm256_storeu_si256(reinterpret_cast<__m256i*>(dst), acc);
+}
+#endif // V_SIMD_256
+
+// each width handles the biggest multiple of its vector size in what remains, 
+// sizes are known at compile time so each helper is called with its own exact size
+template<size_t N, bool Q, size_t W = V_SIMD_MAX>
+void simdActivation(float* RESTRICT x) {
+   if constexpr (N <= 0) return;
+
+#if V_SIMD_512
+   constexpr size_t n512 = W >= 512 ? (N & -16) : 0;
+   if constexpr (n512 > 0) {
+      const v_f32_512 zero = v_zero_f32_512();
+      const v_f32_512 un   = v_set_f32_512(1.f);
+      simdActivation512<n512,Q>(x, zero, un);
+   }
+#else
+   constexpr size_t n512 = 0;
+#endif
+
+#if V_SIMD_256
+   constexpr size_t n256 = W >= 256 ? ((N - n512) & -8) : 0;
+   if constexpr (n256 > 0) {
+      const v_f32_256 zero = v_zero_f32_256();
+      const v_f32_256 un   = v_set_f32_256(1.f);
+      simdActivation256<n256,Q>(x + n512, zero, un);
+   }
+#else
+   constexpr size_t n256 = 0;
+#endif
+
+#if V_SIMD_128
+   constexpr size_t n128 = W >= 128 ? ((N - n512 - n256) & -4) : 0;
+   if constexpr (n128 > 0) {
+      const v_f32_128 zero = v_zero_f32_128();
+      const v_f32_128 un   = v_set_f32_128(1.f);
+      simdActivation128<n128,Q>(x + n512 + n256, zero, un);
+   }
+#else
+   constexpr size_t n128 = 0;
+#endif
+
+   constexpr size_t nDefault = (N - n512 - n256 - n128) & -4;
+   if constexpr (nDefault > 0) {
+      simdActivationDefault<nDefault,Q>(x + n512 + n256 + n128);
+   }
+
+   for (size_t i = n512 + n256 + n128 + nDefault; i < N; ++i) {
+      x[i] = std::min(std::max(x[i], 0.f), 1.f);
+   }
+}
+
+template<size_t N, bool Q, size_t W = V_SIMD_MAX>
+[[nodiscard]] float simdDotProduct(const float* RESTRICT x, const float* RESTRICT y) {
+   float dot = 0.0f;
+   if constexpr (N <= 0) return dot;
+
+#if V_SIMD_512
+   constexpr size_t n512 = W >= 512 ? (N & -16) : 0;
+   if constexpr (n512 > 0) {
+      dot += simdDotProduct512<n512,Q>(x, y);
+   }
+#else
+   constexpr size_t n512 = 0;
+#endif
+
+#if V_SIMD_256
+   constexpr size_t n256 = W >= 256 ? ((N - n512) & -8) : 0;
+   if constexpr (n256 > 0) {
+      dot += simdDotProduct256<n256,Q>(x + n512, y + n512);
+   }
+#else
+   constexpr size_t n256 = 0;
+#endif
+
+#if V_SIMD_128
+   constexpr size_t n128 = W >= 128 ? ((N - n512 - n256) & -4) : 0;
+   if constexpr (n128 > 0) {
+      dot += simdDotProduct128<n128,Q>(x + n512 + n256, y + n512 + n256);
+   }
+#else
+   constexpr size_t n128 = 0;
+#endif
+
+   constexpr size_t nDefault = (N - n512 - n256 - n128) & -4;
+   if constexpr (nDefault > 0) {
+      dot += simdDotProductDefault<nDefault,Q>(x + n512 + n256 + n128, y + n512 + n256 + n128);
+   }
+
+   for (size_t i = n512 + n256 + n128 + nDefault; i < N; ++i) {
+      dot += y[i] * x[i];
+   }
+   return dot;
+}
@@ -8,8 +8,19 @@ template<typename T, size_t dim, bool Q>
 struct StackVector {
    alignas(NNUEALIGNMENT) T data[dim];
 
+#ifdef WITH_ISA_DISPATCH
+   // accumulator updates go through the kernels selected at startup
+   template<typename T2> 
+   static constexpr bool isAccumulator() { return std::is_same_v<T, int16_t> && std::is_same_v<T2, int16_t> && dim == firstInnerLayerSize; }
+#endif
+
    template<typename T2> 
    FORCE_FINLINE StackVector<T, dim, Q>& add_(const T2* other) {
+#ifdef WITH_ISA_DISPATCH
+      if constexpr (isAccumulator<T2>()) {
+         isaKernels.add(data, other);
+      } else
+#endif
 #ifdef USE_SIMD_INTRIN
       if constexpr (std::is_same_v<T, int16_t> && std::is_same_v<T2, int16_t>) {
          simdAdd_i16<dim>(data, other);
@@ -24,6 +35,11 @@ struct StackVector {
 
    template<typename T2> 
    FORCE_FINLINE StackVector<T, dim, Q>& sub_(const T2* other) {
+#ifdef WITH_ISA_DISPATCH
+      if constexpr (isAccumulator<T2>()) {
+         isaKernels.sub(data, other);
+      } else
+#endif
 #ifdef USE_SIMD_INTRIN
       if constexpr (std::is_same_v<T, int16_t> && std::is_same_v<T2, int16_t>) {
          simdSub_i16<dim>(data, other);
@@ -36,6 +52,35 @@ struct StackVector {
       return *this;
    }
 
+   // this = src - subs + adds, in one pass (src may be this)
+   template<size_t NA, size_t NS, typename T2> 
+   FORCE_FINLINE StackVector<T, dim, Q>& addSubFrom_(const StackVector<T, dim, Q>& src, const std::array<const T2*, NA>& adds, const std::array<const T2*, NS>& subs) {
+#ifdef WITH_ISA_DISPATCH
+      if constexpr (isAccumulator<T2>() && NA == 1 && NS == 1) {
+         isaKernels.addSub(data, src.data, adds[0], subs[0]);
+      } else if constexpr (isAccumulator<T2>() && NA == 1 && NS == 2) {
+         isaKernels.addSubSub(data, src.data, adds[0], subs[0], subs[1]);
+      } else if constexpr (isAccumulator<T2>() && NA == 2 && NS == 2) {
+         isaKernels.addAddSubSub(data, src.data, adds[0], adds[1], subs[0], subs[1]);
+      } else
+#endif
+#ifdef USE_SIMD_INTRIN
+      if constexpr (std::is_same_v<T, int16_t> && std::is_same_v<T2, int16_t>) {
+         simdAddSub_i16<dim, NA, NS>(data, src.data, adds, subs);
+      } else
+#endif
+      {
+#pragma omp simd
+         for (size_t i = 0; i < dim; ++i) {
+            T acc = src.data[i];
+            for (size_t k = 0; k < NS; ++k) acc -= subs[k][i];
+            for (size_t k = 0; k < NA; ++k) acc += adds[k][i];
+            data[i] = acc;
+         }
+      }
+      return *this;
+   }
+
 #ifndef USE_SIMD_INTRIN
    template<typename T2, typename T3> 
    FORCE_FINLINE StackVector<T, dim, Q>& fma_(const T2 c, const T3* other) {
@@ -57,6 +102,11 @@ struct StackVector {
 
    template<typename T2> 
    FORCE_FINLINE void from(const T2* other) {
+#ifdef WITH_ISA_DISPATCH
+      if constexpr (isAccumulator<T2>()) {
+         isaKernels.copy(data, other);
+      } else
+#endif
 #ifdef USE_SIMD_INTRIN
       if constexpr (std::is_same_v<T, int16_t> && std::is_same_v<T2, int16_t>) {
          simdCopy_i16<dim>(data, other);
@@ -27,13 +27,188 @@ template<typename NT, bool Q> struct NNUEWeights {
 
    array1d<InnerLayer, nbuckets> innerLayer;
 
+#ifdef USE_SIMD_INTRIN
+   // int8 copy of fc0 used by the integer inference path (see NNUEEval::propagateInt), 
+   // it is not part of the pre-quantized file format and is rebuilt after each load
+   array1d<Int8Layer<2 * firstInnerLayerSize, 8>, nbuckets> fc0Int;
+#ifdef WITH_NNUE_SPARSE
+   // input major copies of fc0 used by the sparse path, rebuilt after each load too
+   array1d<SparseLayer<2 * firstInnerLayerSize, 8>, nbuckets> fc0Sparse;
+#endif
+#endif
+
    uint32_t version {0};
+   uint64_t hash {0}; // identifies the loaded net (see WeightsReader::hash)
+
+   void prepareDerivedLayers() {
+#ifdef USE_SIMD_INTRIN
+      for (int k = 0; k < nbuckets; ++k) fc0Int[k].quantize(innerLayer[k].fc0.W, innerLayer[k].fc0.b);
+#ifdef WITH_NNUE_SPARSE
+      for (int k = 0; k < nbuckets; ++k) fc0Sparse[k].build(innerLayer[k].fc0.W, fc0Int[k]);
+#endif
+#endif
+   }
+
+   // Pre-quantized net file : this header followed by the input layers (weights then bias, already quantized)
+   // and the inner layers (already transposed), exactly as they are laid out in memory.
+   // Every section size is a multiple of NNUEALIGNMENT so that the file can be mapped and used in place.
+   struct alignas(NNUEALIGNMENT) MappedHeader {
+      array1d<char, 8> magic          {'M', 'i', 'n', 'i', 'c', 'N', 'Q', '\0'};
+      uint32_t         formatVersion  {1};
+      uint32_t         netVersion     {0};
+      uint64_t         netHash        {0}; // hash of the original net, so that TT files remain valid
+      uint32_t         inputSize      {static_cast<uint32_t>(inputLayerSize)};
+      uint32_t         firstInnerSize {static_cast<uint32_t>(firstInnerLayerSize)};
+      uint32_t         nbBuckets      {static_cast<uint32_t>(nbuckets)};
+      uint32_t         inputTypeSize  {static_cast<uint32_t>(sizeof(typename Quantization<Q>::WIT))};
+      uint32_t         innerSize      {static_cast<uint32_t>(sizeof(array1d<InnerLayer, nbuckets>))};
+      uint32_t         scale          {static_cast<uint32_t>(Quantization<Q>::scale)};
+#ifdef USE_SIMD_INTRIN
+      uint8_t          transposed     {1};
+#else
+      uint8_t          transposed     {0};
+#endif
+#ifdef WITH_NNUE_UNCERTAINTY
+      uint8_t          uncertainty    {1};
+#else
+      uint8_t          uncertainty    {0};
+#endif
+      [[nodiscard]] bool sameLayout(const MappedHeader& o) const {
+         return formatVersion == o.formatVersion && inputSize == o.inputSize && firstInnerSize == o.firstInnerSize && nbBuckets == o.nbBuckets &&
+                inputTypeSize == o.inputTypeSize && innerSize == o.innerSize && scale == o.scale && transposed == o.transposed &&
+                uncertainty == o.uncertainty;
+      }
+   };
+
+   using InputLayerT = InputLayer<NT, inputLayerSize, firstInnerLayerSize, Q>;
+   static constexpr size_t inputWSize = InputLayerT::nbW * sizeof(typename InputLayerT::WIT);
+   static constexpr size_t inputBSize = sizeof(InputLayerT::b);
+   static constexpr size_t innerSize  = sizeof(array1d<InnerLayer, nbuckets>);
+   static constexpr size_t mappedSize = sizeof(MappedHeader) + 2 * (inputWSize + inputBSize) + innerSize;
+   static_assert(inputWSize % NNUEALIGNMENT == 0 && inputBSize % NNUEALIGNMENT == 0 && innerSize % NNUEALIGNMENT == 0,
+                 "pre-quantized net sections must keep alignment");
+
+   // current mapping, if weights are used in place from a pre-quantized file
+   void*  mappedBase   {nullptr};
+   size_t mappedLength {0};
+
+   void unmap() {
+#ifdef __linux__
+      if (mappedBase) munmap(mappedBase, mappedLength);
+#endif
+      mappedBase   = nullptr;
+      mappedLength = 0;
+   }
+
+   ~NNUEWeights() {
+      // input layers must not point to the mapping anymore when it is released
+      w.ensureOwned();
+      b.ensureOwned();
+      unmap();
+   }
+
+   // write already loaded weights as a pre-quantized net file
+   bool saveMapped(const std::string& path) const {
+      MappedHeader header;
+      header.netVersion = version;
+      header.netHash    = hash;
+      const std::string tmpPath = path + ".tmp";
+      {
+         std::ofstream stream(tmpPath, std::ios_base::out | std::ios_base::binary | std::ios_base::trunc);
+         if (!stream) {
+            Logging::LogIt(Logging::logError) << "Cannot open " << tmpPath << " for writing";
+            return false;
+         }
+         stream.write(reinterpret_cast<const char*>(&header), sizeof(MappedHeader));
+         stream.write(reinterpret_cast<const char*>(w.W), inputWSize);
+         stream.write(reinterpret_cast<const char*>(w.b), inputBSize);
+         stream.write(reinterpret_cast<const char*>(b.W), inputWSize);
+         stream.write(reinterpret_cast<const char*>(b.b), inputBSize);
+         stream.write(reinterpret_cast<const char*>(innerLayer.data()), innerSize);
+         if (!stream) {
+            Logging::LogIt(Logging::logError) << "Error while writing " << tmpPath;
+            return false;
+         }
+      }
+      std::error_code ec;
+      std::filesystem::rename(tmpPath, path, ec);
+      if (ec) {
+         Logging::LogIt(Logging::logError) << "Cannot rename " << tmpPath << " to " << path;
+         return false;
+      }
+      Logging::LogIt(Logging::logInfo) << "Pre-quantized net written to " << path << " (" << mappedSize / 1024 / 1024 << "Mb)";
+      return true;
+   }
+
+   [[nodiscard]] static bool isMappedNet(const std::string& path) {
+      std::ifstream    stream(path, std::ios_base::in | std::ios_base::binary);
+      array1d<char, 8> magic {};
+      stream.read(magic.data(), magic.size());
+      return stream && magic == MappedHeader {}.magic;
+   }
+
+   // use a pre-quantized net file in place : input layers point inside the mapping, only small parts are copied
+   static bool loadMapped(const std::string& path, NNUEWeights<NT, Q>& loadedWeights, const uint32_t expectedVersion) {
+#ifdef __linux__
+      const int fd = open(path.c_str(), O_RDONLY);
+      if (fd < 0) {
+         Logging::LogIt(Logging::logError) << "File " << path << " is not accessible";
+         return false;
+      }
+      struct stat st {};
+      if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) != mappedSize) {
+         close(fd);
+         Logging::LogIt(Logging::logError) << "File " << path << " does not look like a compatible pre-quantized net";
+         return false;
+      }
+      void* mem = mmap(nullptr, mappedSize, PROT_READ, MAP_PRIVATE, fd, 0);
+      close(fd);
+      if (mem == MAP_FAILED) {
+         Logging::LogIt(Logging::logError) << "Cannot map " << path;
+         return false;
+      }
+      const char*         data   = static_cast<const char*>(mem);
+      const MappedHeader& header = *reinterpret_cast<const MappedHeader*>(data);
+      if (!header.sameLayout(MappedHeader {}) || header.netVersion != expectedVersion) {
+         munmap(mem, mappedSize);
+         Logging::LogIt(Logging::logError) << "File " << path << " is not a compatible pre-quantized net (built with other options ?)";
+         return false;
+      }
+      quantizationInfo<Q>();
+      using WIT = typename InputLayerT::WIT;
+      data += sizeof(MappedHeader);
+      // weights are never written once loaded, so a read-only mapping is fine
+      loadedWeights.w.useMapped(reinterpret_cast<WIT*>(const_cast<char*>(data)));
+      data += inputWSize;
+      std::memcpy(loadedWeights.w.b, data, inputBSize);
+      data += inputBSize;
+      loadedWeights.b.useMapped(reinterpret_cast<WIT*>(const_cast<char*>(data)));
+      data += inputWSize;
+      std::memcpy(loadedWeights.b.b, data, inputBSize);
+      data += inputBSize;
+      std::memcpy(static_cast<void*>(loadedWeights.innerLayer.data()), data, innerSize);
+      loadedWeights.unmap(); // previous mapping if any
+      loadedWeights.mappedBase   = mem;
+      loadedWeights.mappedLength = mappedSize;
+      loadedWeights.version      = header.netVersion;
+      loadedWeights.hash         = header.netHash;
+      loadedWeights.prepareDerivedLayers();
+      Logging::LogIt(Logging::logInfo) << "Pre-quantized net mapped from " << path;
+      return true;
+#else
+      (void)loadedWeights;
+      (void)expectedVersion;
+      Logging::LogIt(Logging::logError) << "Pre-quantized net " << path << " can only be used on Linux";
+      return false;
+#endif
+   }
 
    NNUEWeights<NT, Q>& load(WeightsReader<NT>& ws, bool readVersion) {
       quantizationInfo<Q>();
       if (readVersion) ws.readVersion(version);
       w.load_(ws);
       b.load_(ws);
+      unmap(); // input layers are back to their own storage
       for (auto & l : innerLayer) l.fc0.load_(ws);
       for (auto & l : innerLayer) l.fc1.load_(ws);
       for (auto & l : innerLayer) l.fc2.load_(ws);
@@ -41,6 +216,8 @@ template<typename NT, bool Q> struct NNUEWeights {
 #ifdef WITH_NNUE_UNCERTAINTY
       for (auto & l : innerLayer) l.fc3_uncertainty.load_(ws);
 #endif
+      hash = ws.hash;
+      prepareDerivedLayers();
       return *this;
    }
 
@@ -55,6 +232,9 @@ template<typename NT, bool Q> struct NNUEWeights {
 #endif
       [[maybe_unused]] constexpr bool     withVersion     {true}; // used for backward compatiblity and debug
 
+      if (path != "embedded" && isMappedNet(path)) {
+         return loadMapped(path, loadedWeights, expectedVersion);
+      }
       if (path != "embedded") { // read from disk
 #ifndef WITHOUT_FILESYSTEM
          std::error_code ec;
@@ -8,10 +8,16 @@
 template<typename NT> 
 struct WeightsReader {
    std::istream* file = nullptr;
+   uint64_t      hash = 0xcbf29ce484222325ull; // FNV-1a of every byte read, used to identify the net
+
+   void hashBytes(const char* data, const size_t n) {
+      for (size_t k = 0; k < n; ++k) hash = (hash ^ static_cast<uint8_t>(data[k])) * 0x100000001b3ull;
+   }
 
    WeightsReader<NT>& readVersion(uint32_t& version) {
       assert(file);
       file->read((char*)&version, sizeof(uint32_t));
+      hashBytes((const char*)&version, sizeof(uint32_t));
       return *this;
    }
 
@@ -26,6 +32,7 @@ struct WeightsReader {
       
       for (size_t i(0); i < request; ++i) {
          file->read(singleElement.data(), singleElement.size());
+         hashBytes(singleElement.data(), singleElement.size());
          NT tmp {0};
          std::memcpy(&tmp, singleElement.data(), singleElement.size());
          // update min/max
@@ -55,6 +62,7 @@ struct WeightsReader {
       // read each weight one by one, and scale them if quantization is active
       for (size_t i(0); i < request; ++i) {
          file->read(singleElement.data(), singleElement.size());
+         hashBytes(singleElement.data(), singleElement.size());
          NT tmp {0};
          std::memcpy(&tmp, singleElement.data(), singleElement.size());
          // update min/max
@@ -86,6 +94,7 @@ struct WeightsReader {
       // read each bias one by one, and scale them if quantization is active
       for (size_t i(0); i < request; ++i) {
          file->read(singleElement.data(), singleElement.size());
+         hashBytes(singleElement.data(), singleElement.size());
          NT tmp {0};
          std::memcpy(&tmp, singleElement.data(), singleElement.size());
          // update min/max
@@ -109,6 +118,7 @@ struct WeightsReader {
       // read each bias one by one, and scale them if quantization is active
       for (size_t i(0); i < request; ++i) {
          file->read(singleElement.data(), singleElement.size());
+         hashBytes(singleElement.data(), singleElement.size());
          NT tmp {0};
          std::memcpy(&tmp, singleElement.data(), singleElement.size());
          // update min/max
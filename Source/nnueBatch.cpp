@@ -0,0 +1,72 @@
+#include "nnueBatch.hpp"
+
+#ifdef WITH_NNUE
+
+#include "material.hpp"
+#include "nnue.hpp"
+#include "positionTools.hpp"
+#include "tools.hpp"
+
+namespace NNUEBatch {
+
+namespace {
+
+constexpr int nbBuckets = decltype(NNUEEvaluator::weights)::nbuckets;
+
+void evaluateRange(std::span<const RootPosition> positions, std::span<float> scores, const size_t begin, const size_t end) {
+   std::vector<NNUEEvaluator> evaluators(batchSize);
+   array1d<std::vector<size_t>, nbBuckets> ids; // positions of the batch, by bucket
+#ifdef USE_SIMD_INTRIN
+   array1d<const int16_t*, batchSize>             us;
+   array1d<const int16_t*, batchSize>             them;
+   array1d<nnue::EvalWithUncertainty, batchSize> out;
+#endif
+
+   for (size_t start = begin; start < end; start += batchSize) {
+      const size_t n = std::min(batchSize, end - start);
+      for (auto& b : ids) b.clear();
+      for (size_t k = 0; k < n; ++k) {
+         const Position& p = positions[start + k];
+         p.resetNNUEEvaluator(evaluators[k]);
+         ids[bucket(p)].push_back(k);
+      }
+      for (int bucket = 0; bucket < nbBuckets; ++bucket) {
+         const auto& bucketIds = ids[bucket];
+#ifdef USE_SIMD_INTRIN
+         for (size_t j = 0; j < bucketIds.size(); ++j) {
+            const NNUEEvaluator& evaluator = evaluators[bucketIds[j]];
+            const bool           white     = positions[start + bucketIds[j]].c == Co_White;
+            us[j]                          = (white ? evaluator.white : evaluator.black).active().data;
+            them[j]                        = (white ? evaluator.black : evaluator.white).active().data;
+         }
+         NNUEEvaluator::propagateBatch(us.data(), them.data(), bucketIds.size(), bucket, out.data());
+         for (size_t j = 0; j < bucketIds.size(); ++j) scores[start + bucketIds[j]] = out[j].evaluation;
+#else
+         // no batched kernels, one position at a time
+         for (const size_t k : bucketIds) scores[start + k] = evaluators[k].propagate(positions[start + k].c, bucket).evaluation;
+#endif
+      }
+   }
+}
+
+} // namespace
+
+int bucket(const Position& p) {
+   // game phase from material table if possible, as in eval
+   if (const Hash matHash = MaterialHash::getMaterialHash(p.mat); matHash != nullHash) return NNUEWrapper::bucket(MaterialHash::getMaterialEntry(matHash).gamePhase());
+   ScoreType matScoreW = 0;
+   ScoreType matScoreB = 0;
+   return NNUEWrapper::bucket(gamePhase(p.mat, matScoreW, matScoreB));
+}
+
+void evaluate(std::span<const RootPosition> positions, std::span<float> scores, const size_t nbThreads) {
+   assert(scores.size() >= positions.size());
+   if (positions.empty()) return;
+   // no need for more threads than batches
+   const size_t threads = std::clamp<size_t>(nbThreads, 1, (positions.size() + batchSize - 1) / batchSize);
+   threadedWork([&](const size_t begin, const size_t end) { evaluateRange(positions, scores, begin, end); }, threads, positions.size());
+}
+
+} // namespace NNUEBatch
+
+#endif // WITH_NNUE
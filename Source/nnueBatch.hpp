@@ -0,0 +1,31 @@
+#pragma once
+
+#include "definition.hpp"
+
+#ifdef WITH_NNUE
+
+#include <span>
+
+#include "position.hpp"
+
+/*!
+ * Batched NNUE evaluation, for offline workloads (dataset filtering, eval speed, ...)
+ * Positions are processed by batches : accumulators of a whole batch are refreshed into
+ * evaluators owned by the batch, then fc0 is applied to all positions sharing a bucket at once
+ * so that its weights stay in cache (see inference::simdPropagateFloatBatch).
+ * Batches are shared between nbThreads threads.
+ * Scores are the raw net output from the side to move point of view,
+ * without the scaling, contempt and fifty move rule adjustments done in eval.
+ */
+namespace NNUEBatch {
+
+inline constexpr size_t batchSize = 64;
+
+// inner layers bucket of a position, as in eval
+[[nodiscard]] int bucket(const Position& p);
+
+void evaluate(std::span<const RootPosition> positions, std::span<float> scores, const size_t nbThreads);
+
+} // namespace NNUEBatch
+
+#endif // WITH_NNUE
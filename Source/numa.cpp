@@ -0,0 +1,153 @@
+#include "numa.hpp"
+
+#include "logging.hpp"
+
+#ifdef __linux__
+#include <pthread.h>
+#include <sched.h>
+#endif
+
+namespace Numa {
+
+namespace {
+
+#ifdef __linux__
+// parse sysfs cpulist format, for instance "0-7,16-23"
+[[nodiscard]] std::vector<int> parseCpuList(const std::string& s) {
+   std::vector<int> cpus;
+   std::stringstream str(s);
+   std::string range;
+   while (std::getline(str, range, ',')) {
+      if (range.empty()) continue;
+      const size_t dash = range.find('-');
+      const int first = std::atoi(range.substr(0, dash).c_str());
+      const int last  = dash == std::string::npos ? first : std::atoi(range.substr(dash + 1).c_str());
+      for (int cpu = first; cpu <= last; ++cpu) cpus.push_back(cpu);
+   }
+   return cpus;
+}
+#endif
+
+[[nodiscard]] std::vector<std::vector<int>> readTopology() {
+   std::vector<std::vector<int>> nodes;
+#ifdef __linux__
+   // only cpus the process is allowed to run on (taskset, cgroup cpuset) are kept, nodes without any are dropped
+   cpu_set_t allowed;
+   CPU_ZERO(&allowed);
+   const bool hasAllowed = sched_getaffinity(0, sizeof(cpu_set_t), &allowed) == 0;
+   for (int node = 0; ; ++node) {
+      std::ifstream f("/sys/devices/system/node/node" + std::to_string(node) + "/cpulist");
+      if (!f) break;
+      std::string s;
+      std::getline(f, s);
+      std::vector<int> cpus = parseCpuList(s);
+      if (hasAllowed) std::erase_if(cpus, [&](const int cpu) { return cpu < 0 || cpu >= CPU_SETSIZE || !CPU_ISSET(cpu, &allowed); });
+      if (!cpus.empty()) nodes.push_back(std::move(cpus));
+   }
+#endif
+   if (nodes.empty()) nodes.emplace_back();
+   return nodes;
+}
+
+// cpus of the calling thread affinity (empty if not available)
+[[nodiscard]] std::vector<int> currentAffinity() {
+   std::vector<int> cpus;
+#ifdef __linux__
+   cpu_set_t set;
+   CPU_ZERO(&set);
+   if (pthread_getaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) != 0) return cpus;
+   for (int k = 0; k < CPU_SETSIZE; ++k)
+      if (CPU_ISSET(k, &set)) cpus.push_back(k);
+#endif
+   return cpus;
+}
+
+void restoreAffinity(const std::vector<int>& cpus) {
+#ifdef __linux__
+   if (cpus.empty()) return;
+   cpu_set_t set;
+   CPU_ZERO(&set);
+   for (const int cpu : cpus) CPU_SET(cpu, &set);
+   if (pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) != 0) Logging::LogIt(Logging::logWarn) << "Cannot restore thread affinity";
+#else
+   (void)cpus;
+#endif
+}
+
+} // namespace
+
+const std::vector<std::vector<int>>& topology() {
+   static const std::vector<std::vector<int>> nodes = readTopology();
+   return nodes;
+}
+
+size_t nodeCount() { return topology().size(); }
+
+size_t cpuCount() {
+   size_t nbCpus = 0;
+   for (const auto& cpus : topology()) nbCpus += cpus.size();
+   return nbCpus;
+}
+
+bool bindCurrentThreadToNode(const size_t node) {
+#ifdef __linux__
+   const auto& nodes = topology();
+   if (node >= nodes.size() || nodes[node].empty()) return false;
+   cpu_set_t set;
+   CPU_ZERO(&set);
+   for (const int cpu : nodes[node]) CPU_SET(cpu, &set);
+   return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) == 0;
+#else
+   (void)node;
+   return false;
+#endif
+}
+
+bool bindCurrentThreadToCpu(const int cpu) {
+#ifdef __linux__
+   if (cpu < 0 || cpu >= CPU_SETSIZE) return false;
+   cpu_set_t set;
+   CPU_ZERO(&set);
+   CPU_SET(cpu, &set);
+   return pthread_setaffinity_np(pthread_self(), sizeof(cpu_set_t), &set) == 0;
+#else
+   (void)cpu;
+   return false;
+#endif
+}
+
+int cpuForThread(const size_t k, const bool compact) {
+   const auto&  nodes  = topology();
+   const size_t nbCpus = cpuCount();
+   if (nbCpus == 0) return -1;
+   if (compact) {
+      size_t i = k % nbCpus;
+      for (const auto& cpus : nodes) {
+         if (i < cpus.size()) return cpus[i];
+         i -= cpus.size();
+      }
+      return -1;
+   }
+   // spread : node k % n, then next cpu of this node (nodes may not have the same size)
+   for (size_t i = k;; ++i) {
+      const auto& cpus = nodes[i % nodes.size()];
+      if (!cpus.empty()) return cpus[(i / nodes.size()) % cpus.size()];
+   }
+}
+
+size_t nodeOfCpu(const int cpu) {
+   const auto& nodes = topology();
+   for (size_t node = 0; node < nodes.size(); ++node)
+      if (std::ranges::find(nodes[node], cpu) != nodes[node].end()) return node;
+   return 0;
+}
+
+NodeScope::NodeScope(const int cpu) {
+   if (cpu < 0) return;
+   std::vector<int> previous = currentAffinity();
+   if (!previous.empty() && bindCurrentThreadToNode(nodeOfCpu(cpu))) _previous = std::move(previous);
+}
+
+NodeScope::~NodeScope() { restoreAffinity(_previous); }
+
+} // namespace Numa
@@ -0,0 +1,48 @@
+#pragma once
+
+#include "definition.hpp"
+
+/*!
+ * A very light NUMA helper, no libnuma dependency
+ * Topology is read from sysfs on Linux (restricted to the cpus the process is allowed to use), other platforms are seen as a single node
+ * It is used to first-touch memory from the node that will use it, and to pin search threads
+ */
+namespace Numa {
+
+// cpu ids of each NUMA node (at least one node, possibly with an empty cpu list if unknown)
+// read once, from the first calling thread (the main one, before any binding)
+[[nodiscard]] const std::vector<std::vector<int>>& topology();
+
+[[nodiscard]] size_t nodeCount();
+
+// number of cpus over all nodes (0 if topology is unknown)
+[[nodiscard]] size_t cpuCount();
+
+// pin the calling thread on all cpus of the given node, returns false if not possible
+bool bindCurrentThreadToNode(size_t node);
+
+// pin the calling thread on one cpu, returns false if not possible
+bool bindCurrentThreadToCpu(int cpu);
+
+// cpu for the k-th thread, -1 if topology is unknown
+// compact fills a node before using the next one, otherwise threads are spread round robin over nodes
+[[nodiscard]] int cpuForThread(size_t k, bool compact);
+
+// node of the given cpu (0 if unknown)
+[[nodiscard]] size_t nodeOfCpu(int cpu);
+
+// the calling thread is bound to the node of the given cpu during the scope lifetime, its previous affinity
+// is then restored (memory allocated and initialized inside the scope is thus first-touched on this node)
+// nothing is done for a negative cpu
+class NodeScope {
+  public:
+   explicit NodeScope(int cpu);
+   ~NodeScope();
+   NodeScope(const NodeScope&)            = delete;
+   NodeScope& operator=(const NodeScope&) = delete;
+
+  private:
+   std::vector<int> _previous; // cpus of the previous affinity, empty if nothing was changed
+};
+
+} // namespace Numa
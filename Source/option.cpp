@@ -2,6 +2,7 @@
 
 #include "com.hpp"
 #include "dynamicConfig.hpp"
+#include "isa.hpp"
 #include "logging.hpp"
 #include "opponent.hpp"
 #include "searcher.hpp"
@@ -287,12 +288,24 @@ void registerCOMOptions() { // options exposed to GUI
    _keys.emplace_back(k_bool,  w_check, "UCI_LimitStrength"           , &DynamicConfig::limitStrength                  , false            , true);
    _keys.emplace_back(k_int,   w_spin,  "UCI_Elo"                     , &DynamicConfig::strength                       , (int)500         , (int)2800);
    _keys.emplace_back(k_int,   w_spin,  "Hash"                        , &DynamicConfig::ttSizeMb                       , (unsigned int)1  , (unsigned int)256000                , &TT::initTable);
+   _keys.emplace_back(k_string,w_combo, "TTAllocation"                , &DynamicConfig::ttAllocation                   , std::vector<std::string>{ "default", "hugepages", "numa"}             , &TT::initTable);
+   _keys.emplace_back(k_string,w_string,"TTFile"                      , &DynamicConfig::ttFile                                                                                  , &TT::loadTTFile);
+   _keys.emplace_back(k_string,w_string,"TTSharedMemory"              , &DynamicConfig::ttSharedMemory                                                                          , &TT::initTable);
+#ifdef WITH_ISA_DISPATCH
+   _keys.emplace_back(k_string,w_combo, "ISA"                         , &DynamicConfig::isa                            , std::vector<std::string>{ "auto", "avx512", "avx2", "generic"}        , &ISA::init);
+#endif
+   _keys.emplace_back(k_bool,  w_check, "TTSaveOnExit"                , &DynamicConfig::ttSaveOnExit                   , false            , true);
    _keys.emplace_back(k_int,   w_spin,  "PawnHash"                    , &DynamicConfig::ttPawnSizeMb                   , (unsigned int)1  , (unsigned int)4096                  , &ThreadPool::initPawnTables);
+   _keys.emplace_back(k_int,   w_spin,  "EvalCache"                   , &DynamicConfig::evalCacheSizeMb                , (unsigned int)1  , (unsigned int)4096                  , &ThreadPool::initEvalCaches);
    _keys.emplace_back(k_int,   w_spin,  "Threads"                     , &DynamicConfig::threads                        , (unsigned int)1  , (unsigned int)(MAX_THREADS-1)       , std::bind(&ThreadPool::setup, &ThreadPool::instance()));
+   _keys.emplace_back(k_string,w_combo, "ThreadBinding"               , &DynamicConfig::threadBinding                  , std::vector<std::string>{ "none", "compact", "spread"}                , std::bind(&ThreadPool::setup, &ThreadPool::instance()));
+   _keys.emplace_back(k_int,   w_spin,  "HelperStartDepth"            , &DynamicConfig::helperStartDepth               , (unsigned int)1  , (unsigned int)16);
+   _keys.emplace_back(k_bool,  w_check, "DeterministicSMP"            , &DynamicConfig::deterministicSMP               , false            , true);
    _keys.emplace_back(k_bool,  w_check, "UCI_Chess960"                , &DynamicConfig::FRC                            , false            , true);
    _keys.emplace_back(k_bool,  w_check, "Ponder"                      , &DynamicConfig::UCIPonder                      , false            , true);
    _keys.emplace_back(k_bool,  w_check, "MateFinder"                  , &DynamicConfig::mateFinder                     , false            , true);
-   _keys.emplace_back(k_int,   w_spin,  "MultiPV"                     , &DynamicConfig::multiPV                        , (unsigned int)1  , (unsigned int)4);
+   _keys.emplace_back(k_int,   w_spin,  "MultiPV"                     , &DynamicConfig::multiPV                        , (unsigned int)1  , (unsigned int)10);
+   _keys.emplace_back(k_bool,  w_check, "ParallelMultiPV"             , &DynamicConfig::parallelMultiPV                , false            , true);
    _keys.emplace_back(k_int,   w_spin,  "RandomOpen"                  , &DynamicConfig::randomOpen                     , (unsigned int)0  , (unsigned int)100);
    _keys.emplace_back(k_int,   w_spin,  "MinMoveOverHead"             , &DynamicConfig::moveOverHead                   , (unsigned int)10 , (unsigned int)1000);
    _keys.emplace_back(k_score, w_spin,  "Contempt"                    , &DynamicConfig::contempt                       , (ScoreType)-50   , (ScoreType)50);
@@ -421,6 +434,8 @@ void registerCOMOptions() { // options exposed to GUI
    _keys.emplace_back(k_depth, w_spin, "iirMinDepth"                       , &SearchConfig::iirMinDepth                         , DepthType(1)    , DepthType(32)      );
    _keys.emplace_back(k_depth, w_spin, "iirReduction"                      , &SearchConfig::iirReduction                        , DepthType(0)    , DepthType(5)       );
 
+   _keys.emplace_back(k_depth, w_spin, "abdadaMinDepth"                    , &SearchConfig::abdadaMinDepth                      , DepthType(1)    , DepthType(32)      );
+
    _keys.emplace_back(k_depth, w_spin, "ttAlphaCutDepth"                   , &SearchConfig::ttAlphaCutDepth                     , DepthType(1)    , DepthType(8)       );
    _keys.emplace_back(k_score, w_spin, "ttAlphaCutMargin"                  , &SearchConfig::ttAlphaCutMargin                    , ScoreType(0)    , ScoreType(1000)    );
    _keys.emplace_back(k_depth, w_spin, "ttBetaCutDepth"                    , &SearchConfig::ttBetaCutDepth                      , DepthType(1)    , DepthType(8)       );
@@ -492,14 +507,26 @@ void initOptions(int argc, char** argv) {
    GETOPT(debugFile, std::string)
    GETOPT(ttSizeMb, unsigned int)
    GETOPT(ttPawnSizeMb, unsigned int)
+   GETOPT(evalCacheSizeMb, unsigned int)
+   GETOPT(ttAllocation, std::string)
+   GETOPT(ttFile, std::string)
+   GETOPT(ttSaveOnExit, bool)
+   GETOPT(ttSharedMemory, std::string)
+#ifdef WITH_ISA_DISPATCH
+   GETOPT(isa, std::string)
+#endif
    GETOPT(contempt, ScoreType)
    GETOPT(FRC, bool)
    GETOPT(DFRC, bool)
    GETOPT(threads, unsigned int)
+   GETOPT(helperStartDepth, unsigned int)
+   GETOPT(threadBinding, std::string)
+   GETOPT(deterministicSMP, bool)
    GETOPT(mateFinder, bool)
    GETOPT(fullXboardOutput, bool)
    GETOPT(level, unsigned int)
    GETOPT(multiPV, unsigned int)
+   GETOPT(parallelMultiPV, bool)
    GETOPT(randomOpen, unsigned int)
    GETOPT(limitStrength, bool)
    GETOPT(nodesBasedLevel, bool)
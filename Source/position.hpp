@@ -55,10 +55,12 @@ struct RootInformation {
  *  Contains also some usefull accessor
  *
  * Minic is a copy/make engine, so that this structure is copied a lot !
+ * It is thus kept trivially copyable (no vtable, no owned resource) so that
+ * a copy is a plain 224 bytes memcpy (7 x 32 bytes, with default config).
+ * Only RootPosition owns something (the RootInformation).
  */
 struct alignas(32) Position {
-   Position();
-   virtual ~Position();
+   Position() = default;
 
    array1d<Piece, NbSquare> _b {{P_none}}; // works because P_none is in fact 0
    array1d<BitBoard, 6>     _allB {{emptyBitBoard}}; // works because emptyBitBoard is in fact 0
@@ -72,7 +74,7 @@ struct alignas(32) Position {
    // Assumed rule of 3 disrespect
    // the default copy CTOR and copy operator will copy that
    // but only a RootPosition will delete it
-   // (this is way faster than a shared_ptr)
+   // (this is way faster than a shared_ptr, and keeps Position trivially copyable)
    mutable RootInformation* root = nullptr;
 
 #ifdef WITH_NNUE
@@ -291,12 +293,63 @@ struct alignas(32) Position {
       STOP_AND_SUM_TIMER(ResetNNUE)
    }
 
+   template<Color c> void refreshNNUEIndices_(NNUEEvaluator& nnueEvaluator, NNUERefreshCache& cache) const {
+      auto& transformer = nnueEvaluator.template us<c>();
+      auto& entry       = cache.entries[c][getBlock(king[c])];
+      if (entry.valid) {
+         if (cache.stats) cache.stats->incr(Stats::sid_nnueRefreshHits);
+      }
+      else {
+         if (cache.stats) cache.stats->incr(Stats::sid_nnueRefreshMiss);
+         entry.accumulator.from(transformer.weights_->b);
+         for (auto& pieces : entry.pieces) pieces.fill(emptyBitBoard);
+         entry.valid = true;
+      }
+      // only apply the difference between cached pieces and current ones
+      for (Piece pp = P_wp; pp <= P_wk; ++pp) {
+         const BitBoard usBB   = pieces_const(c, pp);
+         const BitBoard themBB = pieces_const(~c, pp);
+         BitBoard&      usCached   = entry.pieces[c][pp - 1];
+         BitBoard&      themCached = entry.pieces[~c][pp - 1];
+         BB::applyOn(usCached & ~usBB, [&](const Square& k) { transformer.weights_->eraseIdx(NNUEIndiceUs(king[c], k, pp), entry.accumulator); });
+         BB::applyOn(usBB & ~usCached, [&](const Square& k) { transformer.weights_->insertIdx(NNUEIndiceUs(king[c], k, pp), entry.accumulator); });
+         BB::applyOn(themCached & ~themBB, [&](const Square& k) { transformer.weights_->eraseIdx(NNUEIndiceThem(king[c], k, pp), entry.accumulator); });
+         BB::applyOn(themBB & ~themCached, [&](const Square& k) { transformer.weights_->insertIdx(NNUEIndiceThem(king[c], k, pp), entry.accumulator); });
+         usCached   = usBB;
+         themCached = themBB;
+      }
+      transformer.active_.from(entry.accumulator.data);
+   }
+
+   // same as resetNNUEEvaluator(nnueEvaluator, color) but using the evaluator refresh cache if any
+   void refreshNNUEEvaluator(NNUEEvaluator& nnueEvaluator, Color color) const {
+      if (!nnueEvaluator.refreshCache) {
+         resetNNUEEvaluator(nnueEvaluator, color);
+         return;
+      }
+      START_TIMER
+      NNUERefreshCache& cache = *nnueEvaluator.refreshCache;
+      if (cache.netHash != NNUEEvaluator::weights.hash) {
+         cache.clear();
+         cache.netHash = NNUEEvaluator::weights.hash;
+      }
+      if (color == Co_White)
+         refreshNNUEIndices_<Co_White>(nnueEvaluator, cache);
+      else
+         refreshNNUEIndices_<Co_Black>(nnueEvaluator, cache);
+      nnueEvaluator.dirty = false;
+      STOP_AND_SUM_TIMER(ResetNNUE)
+   }
+
 #endif
 };
 
+static_assert(std::is_trivially_copyable_v<Position>, "Position is copied a lot in search, it must stay a plain memcpy");
+
 /*!
  * RootPosition only specific responsability is to
  * allocate and delete root pointer
+ * Position has no virtual destructor : a RootPosition must never be deleted through a Position pointer
  */
 struct RootPosition : public Position {
    RootPosition(){
@@ -317,30 +370,26 @@ struct RootPosition : public Position {
    // const bool b = readFEN(fen, rootPos, false, true);
    RootPosition & operator=(const RootPosition &) = delete;
 
-   ~RootPosition() override {
+   ~RootPosition() {
       delete root;
    }
 
 };
 
 #ifdef WITH_NNUE
-template<Color c> void updateNNUEEvaluator(NNUEEvaluator& nnueEvaluator, const MoveInfo& moveInfo) {
+// incremental accumulator updates, from the parent evaluator (that can be nnueEvaluator itself for an in-place update)
+// each perspective is updated using a single fused pass (see FeatureTransformer::addSub and friends)
+template<Color c> void updateNNUEEvaluator(NNUEEvaluator& nnueEvaluator, const NNUEEvaluator& parent, const MoveInfo& moveInfo) {
    START_TIMER
    const Piece fromType = Abs(moveInfo.fromP);
    const Piece toType = Abs(moveInfo.toP);
+   const Piece destType = isPromotion(moveInfo.type) ? promShift(moveInfo.type) : fromType;
    // Prefetch NNUE weight rows for all needed feature indices before incremental updates
 #ifdef WITH_NNUE_PREFETCH
    nnueEvaluator.template us<c>().prefetch(NNUEIndiceUs(moveInfo.king[c], moveInfo.from, fromType));
    nnueEvaluator.template them<c>().prefetch(NNUEIndiceThem(moveInfo.king[~c], moveInfo.from, fromType));
-   if (isPromotion(moveInfo.type)) {
-      const Piece promPieceType = promShift(moveInfo.type);
-      nnueEvaluator.template us<c>().prefetch(NNUEIndiceUs(moveInfo.king[c], moveInfo.to, promPieceType));
-      nnueEvaluator.template them<c>().prefetch(NNUEIndiceThem(moveInfo.king[~c], moveInfo.to, promPieceType));
-   }
-   else {
-      nnueEvaluator.template us<c>().prefetch(NNUEIndiceUs(moveInfo.king[c], moveInfo.to, fromType));
-      nnueEvaluator.template them<c>().prefetch(NNUEIndiceThem(moveInfo.king[~c], moveInfo.to, fromType));
-   }
+   nnueEvaluator.template us<c>().prefetch(NNUEIndiceUs(moveInfo.king[c], moveInfo.to, destType));
+   nnueEvaluator.template them<c>().prefetch(NNUEIndiceThem(moveInfo.king[~c], moveInfo.to, destType));
    if (moveInfo.type == T_ep) {
       const Square epSq = moveInfo.ep + (c == Co_White ? -8 : +8);
       nnueEvaluator.template us<c>().prefetch(NNUEIndiceThem(moveInfo.king[c], epSq, P_wp));
@@ -351,44 +400,37 @@ template<Color c> void updateNNUEEvaluator(NNUEEvaluator& nnueEvaluator, const M
       nnueEvaluator.template them<c>().prefetch(NNUEIndiceUs(moveInfo.king[~c], moveInfo.to, toType));
    }
 #endif
-   nnueEvaluator.template us<c>().erase(NNUEIndiceUs(moveInfo.king[c], moveInfo.from, fromType));
-   nnueEvaluator.template them<c>().erase(NNUEIndiceThem(moveInfo.king[~c], moveInfo.from, fromType));
-   if (isPromotion(moveInfo.type)) {
-      const Piece promPieceType = promShift(moveInfo.type);
-      nnueEvaluator.template us<c>().insert(NNUEIndiceUs(moveInfo.king[c], moveInfo.to, promPieceType));
-      nnueEvaluator.template them<c>().insert(NNUEIndiceThem(moveInfo.king[~c], moveInfo.to, promPieceType));
-   }
-   else {
-      nnueEvaluator.template us<c>().insert(NNUEIndiceUs(moveInfo.king[c], moveInfo.to, fromType));
-      nnueEvaluator.template them<c>().insert(NNUEIndiceThem(moveInfo.king[~c], moveInfo.to, fromType));
-   }
+   const size_t usFrom   = NNUEIndiceUs(moveInfo.king[c], moveInfo.from, fromType);
+   const size_t themFrom = NNUEIndiceThem(moveInfo.king[~c], moveInfo.from, fromType);
+   const size_t usTo     = NNUEIndiceUs(moveInfo.king[c], moveInfo.to, destType);
+   const size_t themTo   = NNUEIndiceThem(moveInfo.king[~c], moveInfo.to, destType);
    if (moveInfo.type == T_ep) {
       const Square epSq = moveInfo.ep + (c == Co_White ? -8 : +8);
-      nnueEvaluator.template us<c>().erase(NNUEIndiceThem(moveInfo.king[c], epSq, P_wp));
-      nnueEvaluator.template them<c>().erase(NNUEIndiceUs(moveInfo.king[~c], epSq, P_wp));
+      nnueEvaluator.template us<c>().addSubSub(parent.template us<c>(), usTo, usFrom, NNUEIndiceThem(moveInfo.king[c], epSq, P_wp));
+      nnueEvaluator.template them<c>().addSubSub(parent.template them<c>(), themTo, themFrom, NNUEIndiceUs(moveInfo.king[~c], epSq, P_wp));
    }
    else if (toType != P_none) {
-      nnueEvaluator.template us<c>().erase(NNUEIndiceThem(moveInfo.king[c], moveInfo.to, toType));
-      nnueEvaluator.template them<c>().erase(NNUEIndiceUs(moveInfo.king[~c], moveInfo.to, toType));
+      nnueEvaluator.template us<c>().addSubSub(parent.template us<c>(), usTo, usFrom, NNUEIndiceThem(moveInfo.king[c], moveInfo.to, toType));
+      nnueEvaluator.template them<c>().addSubSub(parent.template them<c>(), themTo, themFrom, NNUEIndiceUs(moveInfo.king[~c], moveInfo.to, toType));
+   }
+   else {
+      nnueEvaluator.template us<c>().addSub(parent.template us<c>(), usTo, usFrom);
+      nnueEvaluator.template them<c>().addSub(parent.template them<c>(), themTo, themFrom);
    }
    nnueEvaluator.dirty = false;
    STOP_AND_SUM_TIMER(UpdateNNUE)
 }
 
-template<Color c> void updateNNUEEvaluatorThemOnly(NNUEEvaluator& nnueEvaluator, const MoveInfo& moveInfo) {
+// when our king changed bucket, only the opponent perspective can be updated, ours will be refreshed
+template<Color c> void updateNNUEEvaluatorThemOnly(NNUEEvaluator& nnueEvaluator, const NNUEEvaluator& parent, const MoveInfo& moveInfo) {
    START_TIMER
    const Piece fromType = Abs(moveInfo.fromP);
    const Piece toType = Abs(moveInfo.toP);
+   const Piece destType = isPromotion(moveInfo.type) ? promShift(moveInfo.type) : fromType;
    // Prefetch NNUE weight rows for all needed feature indices before incremental updates
 #ifdef WITH_NNUE_PREFETCH
    nnueEvaluator.template them<c>().prefetch(NNUEIndiceThem(moveInfo.king[~c], moveInfo.from, fromType));
-   if (isPromotion(moveInfo.type)) {
-      const Piece promPieceType = promShift(moveInfo.type);
-      nnueEvaluator.template them<c>().prefetch(NNUEIndiceThem(moveInfo.king[~c], moveInfo.to, promPieceType));
-   }
-   else {
-      nnueEvaluator.template them<c>().prefetch(NNUEIndiceThem(moveInfo.king[~c], moveInfo.to, fromType));
-   }
+   nnueEvaluator.template them<c>().prefetch(NNUEIndiceThem(moveInfo.king[~c], moveInfo.to, destType));
    if (moveInfo.type == T_ep) {
       const Square epSq = moveInfo.ep + (c == Co_White ? -8 : +8);
       nnueEvaluator.template them<c>().prefetch(NNUEIndiceUs(moveInfo.king[~c], epSq, P_wp));
@@ -397,21 +439,30 @@ template<Color c> void updateNNUEEvaluatorThemOnly(NNUEEvaluator& nnueEvaluator,
       nnueEvaluator.template them<c>().prefetch(NNUEIndiceUs(moveInfo.king[~c], moveInfo.to, toType));
    }
 #endif
-   nnueEvaluator.template them<c>().erase(NNUEIndiceThem(moveInfo.king[~c], moveInfo.from, fromType));
-   if (isPromotion(moveInfo.type)) {
-      const Piece promPieceType = promShift(moveInfo.type);
-      nnueEvaluator.template them<c>().insert(NNUEIndiceThem(moveInfo.king[~c], moveInfo.to, promPieceType));
-   }
-   else {
-      nnueEvaluator.template them<c>().insert(NNUEIndiceThem(moveInfo.king[~c], moveInfo.to, fromType));
-   }
+   const size_t themFrom = NNUEIndiceThem(moveInfo.king[~c], moveInfo.from, fromType);
+   const size_t themTo   = NNUEIndiceThem(moveInfo.king[~c], moveInfo.to, destType);
    if (moveInfo.type == T_ep) {
       const Square epSq = moveInfo.ep + (c == Co_White ? -8 : +8);
-      nnueEvaluator.template them<c>().erase(NNUEIndiceUs(moveInfo.king[~c], epSq, P_wp));
+      nnueEvaluator.template them<c>().addSubSub(parent.template them<c>(), themTo, themFrom, NNUEIndiceUs(moveInfo.king[~c], epSq, P_wp));
    }
    else if (toType != P_none) {
-      nnueEvaluator.template them<c>().erase(NNUEIndiceUs(moveInfo.king[~c], moveInfo.to, toType));
+      nnueEvaluator.template them<c>().addSubSub(parent.template them<c>(), themTo, themFrom, NNUEIndiceUs(moveInfo.king[~c], moveInfo.to, toType));
    }
+   else {
+      nnueEvaluator.template them<c>().addSub(parent.template them<c>(), themTo, themFrom);
+   }
+   nnueEvaluator.dirty = false;
+   STOP_AND_SUM_TIMER(UpdateNNUE)
+}
+
+// castling seen from the opponent perspective : king and rook are both moving (add2-sub2)
+template<Color c> void updateNNUEEvaluatorThemOnlyCastling(NNUEEvaluator& nnueEvaluator, const NNUEEvaluator& parent, const MoveInfo& moveInfo, const Square rookFrom, const Square rookTo) {
+   START_TIMER
+   nnueEvaluator.template them<c>().addAddSubSub(parent.template them<c>(),
+                                                 NNUEIndiceThem(moveInfo.king[~c], moveInfo.to, P_wk),
+                                                 NNUEIndiceThem(moveInfo.king[~c], rookTo, P_wr),
+                                                 NNUEIndiceThem(moveInfo.king[~c], moveInfo.from, P_wk),
+                                                 NNUEIndiceThem(moveInfo.king[~c], rookFrom, P_wr));
    nnueEvaluator.dirty = false;
    STOP_AND_SUM_TIMER(UpdateNNUE)
 }
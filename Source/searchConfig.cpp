@@ -72,6 +72,8 @@ CONST_SEARCH_TUNING DepthType ttMaxFiftyValideDepth = 92;
 CONST_SEARCH_TUNING DepthType iirMinDepth           = 3;
 CONST_SEARCH_TUNING DepthType iirReduction          = 1;
 
+CONST_SEARCH_TUNING DepthType abdadaMinDepth        = 4;
+
 CONST_SEARCH_TUNING DepthType ttAlphaCutDepth       = 1;
 CONST_SEARCH_TUNING ScoreType ttAlphaCutMargin      = 60;
 CONST_SEARCH_TUNING DepthType ttBetaCutDepth        = 1;
@@ -25,6 +25,7 @@ inline const bool doCapHistoryPruning = true;
 inline const bool doCMHPruning        = true;
 inline const bool doIID               = false;
 inline const bool doIIR               = true;
+inline const bool doABDADA            = true;
 
 enum CoeffNameType { CNT_init = 0, CNT_bonus, CNT_slopeD, CNT_slopeGP, CNT_minDepth, CNT_maxdepth };
 
@@ -128,6 +129,8 @@ extern CONST_SEARCH_TUNING DepthType ttMaxFiftyValideDepth;
 extern CONST_SEARCH_TUNING DepthType iirMinDepth;
 extern CONST_SEARCH_TUNING DepthType iirReduction;
 
+extern CONST_SEARCH_TUNING DepthType abdadaMinDepth;
+
 extern CONST_SEARCH_TUNING DepthType ttAlphaCutDepth;
 extern CONST_SEARCH_TUNING ScoreType ttAlphaCutMargin;
 extern CONST_SEARCH_TUNING DepthType ttBetaCutDepth;
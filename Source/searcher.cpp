@@ -4,6 +4,7 @@
 #include "dynamicConfig.hpp"
 #include "logging.hpp"
 #include "moveApply.hpp"
+#include "numa.hpp"
 #include "xboard.hpp"
 
 TimeType Searcher::getCurrentMoveMs()const{
@@ -143,6 +144,8 @@ ScoreType Searcher::drawScore(const Position& p, DepthType height) const {
 }
 
 void Searcher::idleLoop() {
+   if (const int cpu = ThreadPool::cpuForThread(id()); cpu >= 0 && !Numa::bindCurrentThreadToCpu(cpu))
+      Logging::LogIt(Logging::logWarn) << "Cannot pin thread " << id() << " on cpu " << cpu;
    _searching = false;
    while (true) {
       std::unique_lock lock(_mutex);
@@ -189,6 +192,9 @@ bool Searcher::isMainThread() const { return id() == 0; }
 
 Searcher::Searcher(size_t n): _index(n), _exit(false), _searching(true), _stdThread(&Searcher::idleLoop, this) {
    startTime = Clock::now();
+#ifdef WITH_NNUE
+   nnueRefreshCache.stats = &stats;
+#endif
    wait(); // wait for idleLoop to start in the _stdThread object
 }
 
@@ -215,6 +221,10 @@ bool Searcher::searching() const { return _searching; }
 
 void Searcher::clearGame() {
    clearPawnTT();
+   clearEvalCache();
+#ifdef WITH_NNUE
+   nnueRefreshCache.clear();
+#endif
    stats.init();
    killerT.initKillers();
    historyT.initHistory();
@@ -244,6 +254,7 @@ void Searcher::clearGame() {
 void Searcher::clearSearch(bool forceHistoryClear) {
 #ifdef REPRODUCTIBLE_RESULTS
    clearPawnTT();
+   clearEvalCache();
    forceHistoryClear = true;
 #endif
    stats.init();
@@ -303,14 +314,117 @@ void Searcher::prefetchPawn(Hash h) {
 #endif
 }
 
+void Searcher::initEvalCache() {
+   Logging::LogIt(Logging::logInfo) << "Init eval cache (one per thread)";
+   Logging::LogIt(Logging::logInfo) << "EvalEntry size " << sizeof(EvalEntry);
+   ttSizeEval = powerFloor((SIZE_MULTIPLIER * DynamicConfig::evalCacheSizeMb / DynamicConfig::threads) / sizeof(EvalEntry));
+   assert(BB::countBit(ttSizeEval) == 1); // a power of 2 and not 0 ...
+   tableEval.reset(new EvalEntry[ttSizeEval]);
+   Logging::LogIt(Logging::logInfo) << "Size of eval cache " << ttSizeEval * sizeof(EvalEntry) / 1024 << "Kb (" << ttSizeEval << " entries)";
+}
+
+void Searcher::clearEvalCache() {
+   for (unsigned int k = 0; k < ttSizeEval; ++k) tableEval[k].h = nullHash;
+}
+
+ScoreType Searcher::cachedEval(const Position& p, Hash h, EvalData& data) {
+   assert(h != nullHash);
+   EvalEntry& _e = tableEval[h & (ttSizeEval - 1)];
+   if (_e.h == Hash64to32(h) && _e.fifty == p.fifty && !DynamicConfig::disableTT) {
+      stats.incr(Stats::sid_evalCacheHits);
+      data = _e.data;
+      return _e.score;
+   }
+   stats.incr(Stats::sid_evalCacheMiss);
+   const ScoreType score = eval(p, data, *this);
+   // armageddon and mate scores (from material helpers) depend on height, do not cache them
+   if (!DynamicConfig::armageddon && !isMatingScore(score) && !isMatedScore(score)) {
+      _e.h     = Hash64to32(h);
+      _e.score = score;
+      _e.fifty = p.fifty;
+      _e.data  = data;
+   }
+   return score;
+}
+
+#ifdef WITH_NNUE
+void Searcher::materializeNNUE(const Position& p) {
+   assert(&p.evaluator() == &stack[p.halfmoves].evaluator);
+   // the root evaluator is always clean (see initRootPositionOnStack)
+   int k = p.halfmoves;
+   while (stack[k].evaluator.dirty) {
+      assert(k > 0);
+      --k;
+   }
+   // replay pending updates
+   for (++k; k <= p.halfmoves; ++k) {
+      auto& data = stack[k];
+      if (isValidMove(data.nnueMove)) {
+         // fused update straight from the parent accumulators, no copy needed
+         assert(&stack[k - 1].p.evaluator() == &stack[k - 1].evaluator);
+         applyMoveNNUEUpdate(data.p, MoveInfo(stack[k - 1].p, data.nnueMove), stack[k - 1].p);
+      }
+      else {
+         data.evaluator = stack[k - 1].evaluator; // null move
+      }
+   }
+}
+#endif
+
 std::atomic<bool> Searcher::startLock;
 
+void Searcher::waitForStart() {
+   // C++20 atomic wait is a futex on Linux, parked helpers do not steal cores from the main thread
+   startLock.wait(true);
+}
+
+void Searcher::releaseHelpers() {
+   if (startLock.exchange(false)) {
+      Logging::LogIt(Logging::logInfo) << "Unlocking other threads";
+      // helpers join the turns at a fixed point of the main thread search, whenever they really wake up
+      if (DynamicConfig::deterministicSMP)
+         for (size_t k = 1; k < DynamicConfig::threads; ++k) inTurn[k].store(true);
+      startLock.notify_all();
+   }
+}
+
+std::atomic<size_t>                     Searcher::turn;
+array1d<std::atomic<bool>, MAX_THREADS> Searcher::inTurn;
+
+void Searcher::resetTurns() {
+   for (auto& t : inTurn) t.store(false);
+   inTurn[0].store(true);
+   turn.store(0);
+}
+
+void Searcher::waitTurn() const {
+   for (size_t t = turn.load(); t != id(); t = turn.load()) turn.wait(t);
+}
+
+void Searcher::passTurn() const {
+   const size_t n = DynamicConfig::threads;
+   for (size_t k = 1; k < n; ++k) {
+      if (const size_t next = (id() + k) % n; inTurn[next].load()) {
+         turn.store(next);
+         turn.notify_all();
+         break;
+      }
+   }
+   if (inTurn[id()].load()) waitTurn();
+}
+
+void Searcher::leaveTurns() const {
+   inTurn[id()].store(false);
+   passTurn();
+}
+
 Searcher& Searcher::getCoSearcher(size_t id) {
    static std::map<size_t, std::unique_ptr<Searcher>> coSearchers;
    // init new co-searcher if not already present
    if (!coSearchers.contains(id)) {
       coSearchers[id] = std::unique_ptr<Searcher>(new Searcher(id + MAX_THREADS));
       coSearchers[id]->initPawnTable();
+      coSearchers[id]->initEvalCache();
    }
    return *coSearchers[id];
 }
@@ -433,8 +547,8 @@ void Searcher::writeToGenFile(const Position& p, bool getQuietPos, const ThreadD
             const Hash matHash = MaterialHash::getMaterialHash(pLeaf.mat);
             float gp = 1;
             if (matHash != nullHash) {
-               const MaterialHash::MaterialHashEntry& MEntry = MaterialHash::materialHashTable[matHash];
-               gp                                            = MEntry.gamePhase();
+               const MaterialHash::MaterialHashEntry MEntry = MaterialHash::getMaterialEntry(matHash);
+               gp                                           = MEntry.gamePhase();
             }
             const DepthType depth = static_cast<DepthType>(clampDepth(DynamicConfig::genFenDepth) * gp + clampDepth(DynamicConfig::genFenDepthEG) * (1.f - gp));
 
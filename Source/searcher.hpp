@@ -23,6 +23,7 @@ struct Searcher {
       Position  p;
 #ifdef WITH_NNUE
       NNUEEvaluator evaluator;
+      Move          nnueMove = INVALIDMOVE; // pending accumulator update (NULLMOVE for a null move), see materializeNNUE
 #endif
       Hash      h      = nullHash;
       //EvalData  data;
@@ -103,6 +104,11 @@ struct Searcher {
    TimeType getCurrentMoveMs()const; // use this (and not the variable) to take emergency time into account !
 
    array1d<StackData, MAX_PLY> stack;
+
+#ifdef WITH_NNUE
+   // used when a king changes bucket, see Position::refreshNNUEEvaluator
+   NNUERefreshCache nnueRefreshCache;
+#endif
    [[nodiscard]] bool isBooming(uint16_t halfmove); // from stack
    [[nodiscard]] bool isMoobing(uint16_t halfmove); // from stack
 
@@ -111,6 +117,24 @@ struct Searcher {
    // beta cut more refined statistics are possible and gather using this function
    void updateStatBetaCut(const Position & p, const Move m, const DepthType height);
 
+   // triangular PV table : row h holds the PV of the current node at height h (pvLength[h] moves)
+   // height is always lower than MAX_DEPTH in pvs, so is a PV length
+   array2d<Move, MAX_DEPTH, MAX_DEPTH> pvTable;
+   array1d<DepthType, MAX_DEPTH>        pvLength {};
+
+   FORCE_FINLINE void updatePV(const DepthType height, const Move& m) {
+      stats.incr(Stats::sid_PVupdate);
+      assert(height + 1 < MAX_DEPTH);
+      const DepthType childLength = pvLength[height + 1];
+      pvTable[height][0]          = m;
+      std::copy_n(pvTable[height + 1].begin(), childLength, pvTable[height].begin() + 1);
+      pvLength[height] = static_cast<DepthType>(childLength + 1);
+   }
+
+   // PV found by the last pvs call at height 0, completed from TT if too short to give a ponder move
+   void getRootPV(const Position& p, PVList& pv);
+
+   // used for tuning only (see qsearchNoPruning)
    FORCE_FINLINE void updatePV(PVList& pv, const Move& m, const PVList& childPV) {
       stats.incr(Stats::sid_PVupdate);
       pv.clear();
@@ -125,6 +149,7 @@ struct Searcher {
 #ifdef WITH_NNUE
       rootData.p.associateEvaluator(rootData.evaluator); // stole the evaluator
       rootData.p.resetNNUEEvaluator(rootData.evaluator);
+      rootData.evaluator.refreshCache = &nnueRefreshCache; // will be copied to children evaluators
 #endif
       return rootData.p;
    }
@@ -136,17 +161,22 @@ struct Searcher {
       return childData.p;
    }
 
-   FORCE_FINLINE void initChildEvaluatorOnStack(const Position& parentPosition, Position& childPosition) {
+   // NNUE accumulator updates are lazy : the child evaluator is only marked dirty here
+   // and the move is recorded, the update itself is done by materializeNNUE when the position is evaluated.
+   FORCE_FINLINE void deferChildEvaluatorOnStack([[maybe_unused]] Position& childPosition, [[maybe_unused]] const Move m) {
 #ifdef WITH_NNUE
       auto& childData = stack[childPosition.halfmoves];
-      childData.evaluator = parentPosition.evaluator();
-      childPosition.associateEvaluator(childData.evaluator);
-#else
-      (void)parentPosition;
-      (void)childPosition;
+      if (childData.evaluator.dirty && isValidMove(childData.nnueMove)) stats.incr(Stats::sid_nnueUpdateAvoided); // previous child was never evaluated
+      childPosition.associateEvaluator(childData.evaluator); // mark as dirty
+      childData.nnueMove = m;
 #endif
    }
 
+#ifdef WITH_NNUE
+   // apply all pending accumulator updates from the last clean ancestor up to p
+   void materializeNNUE(const Position& p);
+#endif
+
    void displayStats() const {
       for (size_t k = 0; k < Stats::sid_maxid; ++k) {
          Logging::LogIt(Logging::logInfo) << Stats::Names[k] << " " << stats.counters[(Stats::StatId)k];
@@ -214,7 +244,6 @@ struct Searcher {
                  const Position&              p,
                  DepthType                    depth,
                  DepthType                    height,
-                 PVList&                      pv,
                  DepthType&                   seldepth,
                  DepthType                    extensions,
                  bool                         isInCheck,
@@ -260,6 +289,9 @@ struct Searcher {
                    int                multipv,
                    const std::string& mark = "");
 
+   // parallel multiPV output of the lines shared by all threads, multiPVMoves is updated with them
+   void displaySharedMultiPV(const Position& p, std::vector<MultiPVScores>& multiPVMoves);
+
    void idleLoop();
 
    void startThread();
@@ -285,7 +317,21 @@ struct Searcher {
    [[nodiscard]] const SearchData& getSearchData() const;
    [[nodiscard]] SearchData&       getSearchData();
 
+   // helper threads are parked until the main thread reaches DynamicConfig::helperStartDepth (or its search ends)
    static std::atomic<bool> startLock;
+   static void waitForStart();
+   static void releaseHelpers();
+
+   // deterministic SMP (see DynamicConfig::deterministicSMP) : only one thread searches at a time,
+   // the turn goes to the next searching thread (in id order) every TURNNODES nodes
+   static std::atomic<size_t>                     turn;
+   static array1d<std::atomic<bool>, MAX_THREADS> inTurn; // thread is taking turns
+   static void resetTurns();
+   void        waitTurn() const;
+   void        passTurn() const;
+   void        leaveTurns() const;
+   bool        deterministicSMP = false;
+   Counter     turnNodes        = 0;
 
    std::chrono::time_point<Clock> startTime;
 
@@ -323,6 +369,24 @@ struct Searcher {
 
    void prefetchPawn(Hash h);
 
+   // static evaluation cache, so that eval does not depend on TT entries surviving
+   struct EvalEntry {
+      EvalData  data;
+      MiniHash  h     = nullHash;
+      ScoreType score = 0;
+      uint8_t   fifty = 0; // score includes the fifty move rule scaling
+   };
+
+   std::unique_ptr<Searcher::EvalEntry[]> tableEval = nullptr;
+   uint64_t ttSizeEval = 0;
+
+   void initEvalCache();
+
+   void clearEvalCache();
+
+   // returns eval(p) from the cache if possible, otherwise evaluates and stores the result
+   [[nodiscard]] ScoreType cachedEval(const Position& p, Hash h, EvalData& data);
+
   private:
    ThreadData              _data;
    std::mutex              _mutexPV;
@@ -14,6 +14,86 @@ namespace {
 constexpr unsigned int threadSkipSize = 20;
 constexpr array1d<int,threadSkipSize> skipSize  = {1, 1, 2, 2, 2, 2, 3, 3, 3, 3, 3, 3, 4, 4, 4, 4, 4, 4, 4, 4};
 constexpr array1d<int,threadSkipSize> skipPhase = {0, 1, 0, 1, 2, 3, 0, 1, 2, 3, 4, 5, 0, 1, 2, 3, 4, 5, 6, 7};
+
+// Parallel multiPV : lines shared by all threads
+struct SharedLine {
+   MultiPVScores line;
+   DepthType     depth;
+   uint64_t      seq; // publication order
+};
+struct SharedSlot {
+   Move      m; // INVALIDMOVE if the slot found no line (not enough root moves)
+   ScoreType s;
+   DepthType depth;
+};
+std::mutex              sharedMultiPVMutex;
+std::vector<SharedLine> sharedLines; // deepest line found so far for each root move
+std::vector<SharedSlot> sharedSlots; // last line completed in each slot
+uint64_t                sharedSeq = 0;
+
+void resetSharedMultiPV(const unsigned int multiPV) {
+   const std::lock_guard lock(sharedMultiPVMutex);
+   sharedLines.clear();
+   sharedSlots.assign(multiPV, {INVALIDMOVE, 0, 0});
+   sharedSeq = 0;
+}
+
+void publishSharedMultiPV(const unsigned int multi, const DepthType depth, const MultiPVScores& line) {
+   const std::lock_guard lock(sharedMultiPVMutex);
+   if (multi >= sharedSlots.size() || depth < sharedSlots[multi].depth) return; // from a late thread of this slot
+   const Move m        = line.pv.empty() ? INVALIDMOVE : line.pv[0];
+   sharedSlots[multi] = {m, line.s, depth};
+   if (!isValidMove(m)) return;
+   const auto it = std::ranges::find_if(sharedLines, [&](const SharedLine& l) { return sameMove(l.line.pv[0], m); });
+   if (it == sharedLines.end()) sharedLines.push_back({line, depth, ++sharedSeq});
+   else if (depth >= it->depth) *it = {line, depth, ++sharedSeq};
+   else it->seq = ++sharedSeq;
+}
+
+// lines to output (lock must be held) : the line of the first slot gives the best move and stays first, then by decreasing score
+std::vector<SharedLine> rankSharedMultiPV() {
+   std::vector<SharedLine> lines;
+   const auto isIn = [&](const Move m) { return std::ranges::any_of(lines, [&](const SharedLine& l) { return sameMove(l.line.pv[0], m); }); };
+   for (const auto& slot : sharedSlots) {
+      if (!isValidMove(slot.m) || isIn(slot.m)) continue;
+      lines.push_back(*std::ranges::find_if(sharedLines, [&](const SharedLine& l) { return sameMove(l.line.pv[0], slot.m); }));
+   }
+   // a root move just found by two slots leaves a hole, filled with the most recent other line
+   std::vector<SharedLine> others;
+   for (const auto& l : sharedLines)
+      if (!isIn(l.line.pv[0])) others.push_back(l);
+   std::ranges::sort(others, [](const SharedLine& a, const SharedLine& b) { return a.seq > b.seq; });
+   for (size_t k = 0; k < others.size() && lines.size() < sharedSlots.size(); ++k) lines.push_back(others[k]);
+   const size_t first = isValidMove(sharedSlots[0].m) ? 1 : 0;
+   if (lines.size() > first) std::stable_sort(lines.begin() + first, lines.end(), [](const SharedLine& a, const SharedLine& b) { return a.line.s > b.line.s; });
+   return lines;
+}
+
+std::vector<SharedLine> rankedSharedMultiPV() {
+   const std::lock_guard lock(sharedMultiPVMutex);
+   return rankSharedMultiPV();
+}
+
+// root moves of the previous slots
+std::vector<MiniMove> sharedSkipMoves(const unsigned int multi) {
+   std::vector<MiniMove> skipMoves;
+   const std::lock_guard lock(sharedMultiPVMutex);
+   for (unsigned int k = 0; k < multi && k < sharedSlots.size(); ++k)
+      if (isValidMove(sharedSlots[k].m)) skipMoves.emplace_back(Move2MiniMove(sharedSlots[k].m));
+   return skipMoves;
+}
+
+// every slot reached depth with a distinct root move, a mated slot is not searched anymore (as in the sequential multiPV loop)
+bool sharedMultiPVReached(const DepthType depth) {
+   const std::lock_guard lock(sharedMultiPVMutex);
+   for (size_t k = 0; k < sharedSlots.size(); ++k) {
+      const SharedSlot& slot = sharedSlots[k];
+      if (slot.depth < depth && !(slot.depth > 0 && isMatedScore(slot.s))) return false;
+      for (size_t j = 0; j < k; ++j)
+         if (isValidMove(slot.m) && sameMove(slot.m, sharedSlots[j].m)) return false;
+   }
+   return true;
+}
 } // namespace
 
 // Output following chosen protocol
@@ -79,6 +159,30 @@ void Searcher::displayGUI(DepthType          depth,
    Logging::LogIt(Logging::logGUI) << str.str();
 }
 
+void Searcher::displaySharedMultiPV(const Position& p, std::vector<MultiPVScores>& multiPVMoves) {
+   const std::vector<SharedLine> lines = rankedSharedMultiPV();
+   for (size_t k = 0; k < lines.size() && k < multiPVMoves.size(); ++k) {
+      multiPVMoves[k] = lines[k].line;
+      displayGUI(lines[k].depth, lines[k].line.seldepth, lines[k].line.s, p.halfmoves, lines[k].line.pv, static_cast<int>(k + 1));
+   }
+}
+
+void Searcher::getRootPV(const Position& p, PVList& pv) {
+   pv.assign(pvTable[0].begin(), pvTable[0].begin() + pvLength[0]);
+   // the line may be cut by a TT or TB hit just after the root move, the ponder move is then taken from TT
+   if (pv.size() != 1) return;
+   Position p2 = p;
+#ifdef WITH_NNUE
+   NNUEEvaluator evaluator;
+   p2.associateEvaluator(evaluator);
+   p2.resetNNUEEvaluator(p2.evaluator());
+#endif
+   if (const MoveInfo moveInfo(p2, pv[0]); !applyMove(p2, moveInfo)) return;
+   PVList ttPV;
+   TT::getPV(p2, *this, ttPV);
+   if (!ttPV.empty()) pv.emplace_back(ttPV[0]);
+}
+
 void Searcher::searchDriver(bool postMove) {
    //stopFlag = false; // shall be only done outside to avoid race condition
    height_ = 0;
@@ -112,8 +216,13 @@ void Searcher::searchDriver(bool postMove) {
    positionEvolution = MoveDifficultyUtil::PE_std;
    startTime      = Clock::now();
 
+   // deterministic SMP is only for the threads of the pool
+   deterministicSMP = DynamicConfig::deterministicSMP && DynamicConfig::threads > 1 && !subSearch && id() < MAX_THREADS;
+   turnNodes = 0; // turns are taken at the same nodes whatever the previous searches
+
    // Main thread only will reset tables
    if (isMainThread()) {
+      if (deterministicSMP) resetTurns();
       TT::age();
       MoveDifficultyUtil::variability = 1.f; // not usefull for co-searcher threads that won't depend on time
       ThreadPool::instance().clearSearch();  // reset tables for all threads !
@@ -149,7 +258,8 @@ void Searcher::searchDriver(bool postMove) {
    // other threads will wait here for start signal
    else {
       Logging::LogIt(Logging::logInfo) << "helper thread waiting ... " << id();
-      while (startLock.load()) { ; }
+      waitForStart();
+      if (deterministicSMP) waitTurn();
       Logging::LogIt(Logging::logInfo) << "... go for id " << id();
    }
 
@@ -166,6 +276,17 @@ void Searcher::searchDriver(bool postMove) {
    // in multipv mode _data.score cannot be use a the aspiration loop score
    std::vector<ScoreType> currentScore(DynamicConfig::multiPV, 0);
 
+   // parallel multiPV : PV slots are split over the threads (slot is thread id modulo multiPV) so that all lines progress at the same time.
+   // A slot skips the root moves of the previous slots, as last found by the other threads.
+   // With less threads than slots, a thread searches one slot every "threads" slots.
+   const bool parallelMultiPV = DynamicConfig::parallelMultiPV && DynamicConfig::multiPV > 1 && DynamicConfig::threads > 1 && !subSearch &&
+                                !(Skill::enabled() && !DynamicConfig::nodesBasedLevel);
+   const unsigned int multiFirst  = parallelMultiPV ? static_cast<unsigned int>(id() % DynamicConfig::multiPV) : 0;
+   const unsigned int multiStride = parallelMultiPV ? std::min(DynamicConfig::threads, DynamicConfig::multiPV) : 1;
+   // rank of the thread among the ones sharing its slot (the first one never skips a depth)
+   const size_t slotRank = parallelMultiPV ? id() / DynamicConfig::multiPV : id();
+   if (parallelMultiPV && isMainThread()) resetSharedMultiPV(DynamicConfig::multiPV);
+
    // handle "maxNodes" style search (will always complete depth 1 search)
    const auto maxNodes = TimeMan::maxNodes;
    // reset this for depth 1 to be sure to iterate at least once ...
@@ -207,7 +328,8 @@ void Searcher::searchDriver(bool postMove) {
    // forced move detection
    // only main thread here (stopflag will be triggered anyway for other threads if needed)
    if (!Distributed::moreThanOneProcess() && isMainThread() && DynamicConfig::multiPV == 1 && isFiniteTimeSearch && currentMoveMs > 100) { ///@todo should work with nps here
-      _data.score = pvs<true>(matedScore(0), matingScore(0), p, 1, 0, _data.pv, _data.seldepth, 0, isInCheck, false); // depth 1 search to get real valid moves
+      _data.score = pvs<true>(matedScore(0), matingScore(0), p, 1, 0, _data.seldepth, 0, isInCheck, false); // depth 1 search to get real valid moves
+      getRootPV(p, _data.pv);
       // only one : check evasion or zugzwang
       if (rootScores.size() == 1) {
          moveDifficulty = MoveDifficultyUtil::MD_forced;
@@ -219,22 +341,18 @@ void Searcher::searchDriver(bool postMove) {
 
       // MultiPV loop
       std::vector<MiniMove> skipMoves;
-      for (unsigned int multi = 0; multi < DynamicConfig::multiPV && !stopFlag; ++multi) {
+      for (unsigned int multi = multiFirst; multi < DynamicConfig::multiPV && !stopFlag; multi += multiStride) {
+         if (parallelMultiPV) skipMoves = sharedSkipMoves(multi);
          // No need to continue multiPV loop if a mate is found
          if (!skipMoves.empty() && isMatedScore(currentScore[multi])) break;
 
          if (isMainThread()) {
-            if (depth > 1) {
-               // delayed other thread start (can use a depth condition...)
-               if (startLock.load()) {
-                  Logging::LogIt(Logging::logInfo) << "Unlocking other threads";
-                  startLock.store(false);
-               }
-            }
+            // delayed other thread start
+            if (depth >= static_cast<DepthType>(DynamicConfig::helperStartDepth)) releaseHelpers();
          }
          // stockfish like thread management (not for co-searcher)
-         else if (!subSearch) {
-            const auto i = (id() - 1) % threadSkipSize;
+         else if (!subSearch && slotRank > 0) {
+            const auto i = (slotRank - 1) % threadSkipSize;
             if (((depth + skipPhase[i]) / skipSize[i]) % 2){
                Logging::LogIt(Logging::logInfo) << "Thread " << id() << " skipping depth " << static_cast<int>(depth);
                continue; // next depth
@@ -269,9 +387,9 @@ void Searcher::searchDriver(bool postMove) {
 
          // Aspiration loop
          while (!stopFlag) {
-            pvLoc.clear();
-            score = pvs<true>(alpha, beta, p, windowDepth, 0, pvLoc, _data.seldepth, 0, isInCheck, false, skipMoves.empty() ? nullptr : &skipMoves);
+            score = pvs<true>(alpha, beta, p, windowDepth, 0, _data.seldepth, 0, isInCheck, false, skipMoves.empty() ? nullptr : &skipMoves);
             if (stopFlag) break;
+            getRootPV(p, pvLoc);
             ScoreType matW = 0;
             ScoreType matB = 0;
             delta += static_cast<ScoreType>((delta / 4) * std::exp(1.f - gamePhase(p.mat,matW,matB))); // in end-game, open window faster
@@ -325,6 +443,7 @@ void Searcher::searchDriver(bool postMove) {
             multiPVMoves[multi].s = score;
             multiPVMoves[multi].pv = pvLoc;
             multiPVMoves[multi].seldepth = _data.seldepth;
+            if (parallelMultiPV) publishSharedMultiPV(multi, depth, multiPVMoves[multi]);
 
             // update the outputed pv only with the best move line
             if (multi == 0) {
@@ -336,7 +455,9 @@ void Searcher::searchDriver(bool postMove) {
 
             if (isMainThread()) {
                // output to GUI
-               displayGUI(depth, _data.seldepth, multiPVMoves[multi].s, p.halfmoves, pvLoc, multi + 1);
+               if (!parallelMultiPV) displayGUI(depth, _data.seldepth, multiPVMoves[multi].s, p.halfmoves, pvLoc, multi + 1);
+               // all lines, each one at its own depth
+               else if (multi == 0) displaySharedMultiPV(p, multiPVMoves);
             }
 
             if (isMainThread() && multi == 0) {
@@ -417,8 +538,17 @@ pvsout:
 
    if (isMainThread()) {
       // in case of very very short depth or time, "others" threads may still be blocked
-      Logging::LogIt(Logging::logInfo) << "Unlocking other threads (end of search)";
-      startLock.store(false);
+      releaseHelpers();
+
+      // parallel multiPV in a depth limited search : other slots are given the time to reach the same depth
+      if (parallelMultiPV && !stopFlag) {
+         const auto helperSearching = [](const auto& s) { return !(*s).isMainThread() && (*s).searching(); };
+         while (!stopFlag && !sharedMultiPVReached(_data.depth) && std::ranges::any_of(ThreadPool::instance(), helperSearching)) {
+            if (deterministicSMP) passTurn();
+            else std::this_thread::sleep_for(std::chrono::milliseconds(1));
+         }
+         displaySharedMultiPV(p, multiPVMoves);
+      }
 
       // all threads are updating their output values but main one is looking for the longest pv
       // note that depth, score, seldepth and pv are already updated on-the-fly
@@ -471,12 +601,17 @@ pvsout:
       // wait for "ponderhit" or "stop" in case search returned too soon
       if (!stopFlag && (getData().isPondering || getData().isAnalysis)) {
          Logging::LogIt(Logging::logInfo) << "Waiting for ponderhit or stop ...";
-         while (!stopFlag && (getData().isPondering || getData().isAnalysis)) { std::this_thread::sleep_for(std::chrono::milliseconds(1)); }
+         while (!stopFlag && (getData().isPondering || getData().isAnalysis)) {
+            if (deterministicSMP) passTurn();
+            else std::this_thread::sleep_for(std::chrono::milliseconds(1));
+         }
          Logging::LogIt(Logging::logInfo) << "... ok";
       }
 
       // now send stopflag to all threads
       ThreadPool::instance().stop();
+      // in deterministic SMP mode, they will see it only once the main thread gives its turn away
+      if (deterministicSMP) leaveTurns();
       // and wait for them
       ThreadPool::instance().wait(true);
 
@@ -515,5 +650,7 @@ pvsout:
 
    Logging::LogIt(Logging::logInfoPrio) << "End of search driver for thread " << id();
 
+   if (deterministicSMP && !isMainThread()) leaveTurns();
+
    _searching = false;
 }
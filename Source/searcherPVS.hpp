@@ -1,5 +1,6 @@
 #pragma once
 
+#include "abdada.hpp"
 #include "definition.hpp"
 #include "distributed.h"
 #include "dynamicConfig.hpp"
@@ -17,6 +18,7 @@
 #include "transposition.hpp"
 
 #define PERIODICCHECK uint64_t(1024)
+#define TURNNODES Counter(1024)
 
 // be carefull isBadCap shall only be used on moves already detected as capture !
 [[nodiscard]] inline bool isBadCap(const Move m) { return badCapScore(m) < DynamicConfig::badCapLimit; }
@@ -437,15 +439,18 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
                         const Position&              p,
                         DepthType                    depth,
                         DepthType                    height,
-                        PVList&                      pv,
                         DepthType&                   seldepth,
                         DepthType                    extensions,
                         bool                         isInCheck_,
                         bool                         cutNode_,
                         const std::vector<MiniMove>* skipMoves) {
 
+   // PV of this node starts empty, it is filled on alpha improvement (pvnode only)
+   pvLength[height] = 0;
+
    // stopFlag management and time check. Only on main thread and not at each node (see PERIODICCHECK)
    if (isMainThread() || isStoppableCoSearcher) timeCheck();
+   if (deterministicSMP && ++turnNodes % TURNNODES == 0) passTurn();
    if (stopFlag) return STOPSCORE;
 
    debug_king_cap(p);
@@ -524,7 +529,7 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
    if (p.mat[Co_White][M_t] + p.mat[Co_Black][M_t] < 5) {
       matHash = MaterialHash::getMaterialHash(p.mat);
       if ( matHash != nullHash ){
-         const MaterialHash::MaterialHashEntry& MEntry = MaterialHash::materialHashTable[matHash];
+         const MaterialHash::MaterialHashEntry MEntry = MaterialHash::getMaterialEntry(matHash);
          terminaison = MEntry.t;
       }
    }
@@ -669,7 +674,7 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
          matHash = matHash != nullHash ? matHash : MaterialHash::getMaterialHash(p.mat);
          if (matHash != nullHash) {
             stats.incr(Stats::sid_materialTableHitsSearch);
-            const MaterialHash::MaterialHashEntry& MEntry = MaterialHash::materialHashTable[matHash];
+            const MaterialHash::MaterialHashEntry MEntry = MaterialHash::getMaterialEntry(matHash);
             evalData.gp = MEntry.gamePhase();
          }
          else { 
@@ -682,7 +687,7 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
       // if no TT hit call evaluation
       else {
          stats.incr(Stats::sid_ttscmiss);
-         evalScore = eval(p, evalData, *this);
+         evalScore = cachedEval(p, pHash, evalData);
 #ifdef DEBUG_STATICEVAL
          checkEval(p,evalScore,*this,"from eval (pvs)");
  #endif
@@ -707,10 +712,6 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
    const ScoreType correctedStaticScore = correctedEval(p, staticScore);
 #endif
 
-   // if no TT hit yet, we insert an eval without a move here in case of forward pruning (depth is negative, bound is none) ...
-   // Be carefull here, _data2 in Entry is always (INVALIDMOVE,B_none,-2) here, so that collisions are a lot more likely
-   if (!pvsData.ttHit) TT::setEntry(*this, pHash, INVALIDMOVE, TT::createHashScore(evalScore, height), TT::createHashScore(staticScore, height), TT::B_none, -2, isMainThread());
-
    // if TT hit, we can use entry score as a best draft 
    // but we set evalScoreIsHashScore to be aware of that !
    if (pvsData.ttHit && e.d > 0 && !pvsData.isInCheck && !pvsData.isKnownEndGame
@@ -864,7 +865,6 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
              pruningEval >= pruningEvalBaseline &&
              stack[p.halfmoves].p.lastMove != NULLMOVE && 
              (height >= nullMoveMinPly || nullMoveVerifColor != p.c)) {
-            PVList nullPV;
             stats.incr(Stats::sid_nullMoveTry);
             const DepthType R = SearchConfig::nullMoveReductionInit +
                               depth / SearchConfig::nullMoveReductionDepthDivisor + 
@@ -874,8 +874,9 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
             pN = p;
             applyNull(*this, pN);
             assert(pN.halfmoves < MAX_PLY && pN.halfmoves >= 0);
+            deferChildEvaluatorOnStack(pN, NULLMOVE);
             stack[pN.halfmoves].h = pN.h;
-            ScoreType nullscore   = -pvs<false>(-beta, -beta + 1, pN, nullDepth, height + 1, nullPV, seldepth, extensions, pvsData.isInCheck, !pvsData.cutNode);
+            ScoreType nullscore   = -pvs<false>(-beta, -beta + 1, pN, nullDepth, height + 1, seldepth, extensions, pvsData.isInCheck, !pvsData.cutNode);
             if (stopFlag) return STOPSCORE;
             TT::Entry nullEThreat;
             TT::getEntry(*this, pN, computeHash(pN), 0, nullEThreat);
@@ -886,7 +887,7 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
                   stats.incr(Stats::sid_nullMoveTry3);
                   nullMoveMinPly = height + 3*nullDepth/4;
                   nullMoveVerifColor = p.c;
-                  nullscore = pvs<false>(beta - 1, beta, p, nullDepth, height+1, nullPV, seldepth, extensions, pvsData.isInCheck, false);
+                  nullscore = pvs<false>(beta - 1, beta, p, nullDepth, height+1, seldepth, extensions, pvsData.isInCheck, false);
                   nullMoveMinPly = 0;
                   nullMoveVerifColor = Co_None;
                   if (stopFlag) return STOPSCORE;
@@ -930,17 +931,15 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
                if (!applyMove(p2, moveInfo, true)) continue;
                stack[p2.halfmoves].h = p2.h;
 #ifdef WITH_NNUE
-               initChildEvaluatorOnStack(p, p2);
-               applyMoveNNUEUpdate(p2, moveInfo);
+               deferChildEvaluatorOnStack(p2, moveInfo.m);
 #endif
                ++probCutCount;
                ScoreType scorePC = -qsearch(-betaPC, -betaPC + 1, p2, height + 1, seldepth, 0, true, pvnode);
-               PVList pcPV;
                if (stopFlag) return STOPSCORE;
                const DepthType probCutSearchDepth = depth / SearchConfig::probCutSearchDepthFactor;
                if (scorePC >= betaPC) {
                   stats.incr(Stats::sid_probcutTry2);
-                  scorePC = -pvs<false>(-betaPC, -betaPC + 1, p2, probCutSearchDepth, height + 1, pcPV, seldepth, extensions, 
+                  scorePC = -pvs<false>(-betaPC, -betaPC + 1, p2, probCutSearchDepth, height + 1, seldepth, extensions, 
                                        isPosInCheck(p2), !pvsData.cutNode);
                }
                if (stopFlag) return STOPSCORE;
@@ -979,9 +978,9 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
    if (SearchConfig::doIID && !pvsData.validTTmove /*|| e.d < depth-4*/) {
       if ((pvnode && depth >= SearchConfig::iidMinDepth) || (pvsData.cutNode && depth >= SearchConfig::iidMinDepth2)) { ///@todo try with cutNode only ?
          stats.incr(Stats::sid_iid);
-         PVList iidPV;
-         DISCARD pvs<pvnode>(alpha, beta, p, depth / 2, height, iidPV, seldepth, extensions, pvsData.isInCheck, pvsData.cutNode, skipMoves);
+         DISCARD pvs<pvnode>(alpha, beta, p, depth / 2, height, seldepth, extensions, pvsData.isInCheck, pvsData.cutNode, skipMoves);
          if (stopFlag) return STOPSCORE;
+         pvLength[height] = 0; // the IID line is not the one of this node
          TT::getEntry(*this, p, pHash, 0, e);
          pvsData.ttHit       = e.h != nullHash;
          pvsData.validTTmove = pvsData.ttHit && e.m != INVALIDMINIMOVE;
@@ -1086,10 +1085,9 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
             && (pvsData.bound == TT::B_exact || pvsData.bound == TT::B_beta)
             && e.d >= depth - SearchConfig::singularExtensionDepthMinus) {
             const ScoreType betaC = e.s - 2 * depth;
-            PVList sePV;
             DepthType seSeldepth = 0;
             std::vector<MiniMove> skip{e.m};
-            const ScoreType score = pvs<false>(betaC - 1, betaC, p, depth / 2, height, sePV, seSeldepth, extensions, pvsData.isInCheck, pvsData.cutNode, &skip);
+            const ScoreType score = pvs<false>(betaC - 1, betaC, p, depth / 2, height, seSeldepth, extensions, pvsData.isInCheck, pvsData.cutNode, &skip);
             if (stopFlag) return STOPSCORE;
             if (score < betaC /*&& extensions <= 6*/) { // TT move is singular
                stats.incr(Stats::sid_singularExtension);
@@ -1113,7 +1111,7 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
             }
             // if TT move is above beta, we try a reduce search early to see if another move is above beta (from SF)
             else if (e.s >= beta) {
-               //const ScoreType score2 = pvs<false>(beta - 1, beta, p, depth - 4, height, sePV, seSeldepth, extensions, pvsData.isInCheck, pvsData.cutNode, &skip);
+               //const ScoreType score2 = pvs<false>(beta - 1, beta, p, depth - 4, height, seSeldepth, extensions, pvsData.isInCheck, pvsData.cutNode, &skip);
                //if (score2 > beta) return stats.incr(Stats::sid_singularExtension4), beta; // fail-hard
                extension = -2 + pvsData.pvnode;
                stats.incr(Stats::sid_singularExtension4);
@@ -1139,8 +1137,7 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
          TT::prefetch(computeHash(p2));
 
 #ifdef WITH_NNUE
-         initChildEvaluatorOnStack(p, p2);
-         applyMoveNNUEUpdate(p2, moveInfo);
+         deferChildEvaluatorOnStack(p2, moveInfo.m);
 #endif
 
          ++pvsData.validMoveCount;
@@ -1162,9 +1159,8 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
          }
 #endif
 
-         PVList childPV;
          ScoreType ttScore;
-         ttScore = -pvs<pvnode>(-beta, -alpha, p2, depth - 1 + extension, height + 1, childPV, seldepth, static_cast<DepthType>(extensions + extension), pvsData.isCheck, !pvsData.cutNode);
+         ttScore = -pvs<pvnode>(-beta, -alpha, p2, depth - 1 + extension, height + 1, seldepth, static_cast<DepthType>(extensions + extension), pvsData.isCheck, !pvsData.cutNode);
 
          if (stopFlag) return STOPSCORE;
 
@@ -1180,7 +1176,7 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
             if (ttScore > alpha) {
                hashBound = TT::B_exact;
                pvsData.alphaUpdated = true;
-               if constexpr(pvnode) updatePV(pv, bestMove, childPV);
+               if constexpr(pvnode) updatePV(height, bestMove);
                if (ttScore >= beta) {
                   stats.incr(Stats::sid_ttbeta);
 
@@ -1215,25 +1211,46 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
    bool skipQuiet = false;
    bool skipCap = false;
 
-   // depending if probecut already generates capture or not, generate all moves or only missing quiets
-   if (!moveGenerated) {
-      if (capMoveGenerated) MoveGen::generate<MoveGen::GP_quiet>(p, moves, true);
-      else
-         if ( pvsData.isInCheck ) MoveGen::generate<MoveGen::GP_evasion>(p, moves, false);
-         else MoveGen::generate<MoveGen::GP_all>(p, moves, false);
+   // moves are generated by stage (see MovePicker), captures from probcut are reused
+   // evasions, root node (TB root moves) and variants with mandatory moves still generate everything at once
+#ifdef USE_PARTIAL_SORT
+   const bool staged = !moveGenerated && !pvsData.isInCheck && !pvsData.rootnode && !DynamicConfig::anarchy && !DynamicConfig::antichess;
+#else
+   constexpr bool staged = false;
+#endif
+
+   if (!staged) {
+      // depending if probecut already generates capture or not, generate all moves or only missing quiets
+      if (!moveGenerated) {
+         if (capMoveGenerated) MoveGen::generate<MoveGen::GP_quiet>(p, moves, true);
+         else
+            if ( pvsData.isInCheck ) MoveGen::generate<MoveGen::GP_evasion>(p, moves, false);
+            else MoveGen::generate<MoveGen::GP_all>(p, moves, false);
+      }
+      if (moves.empty()) return pvsData.isInCheck ? matedScore(height) : drawScore(p, height);
    }
-   if (moves.empty()) return pvsData.isInCheck ? matedScore(height) : drawScore(p, height);
 
 #ifdef USE_PARTIAL_SORT
    MoveSorter ms(*this, p, evalData.gp, height, pvsData.cmhPtr, true, pvsData.isInCheck, pvsData.validTTmove ? &e : nullptr,
                  refutation != INVALIDMINIMOVE && isCapture(Move2Type(refutation)) ? refutation : INVALIDMINIMOVE);
-   ms.score(moves);
-   size_t offset = 0;
+   MovePicker mp(ms, moves, !staged ? MovePicker::ST_all : capMoveGenerated ? MovePicker::ST_goodCaptures : MovePicker::ST_genCaptures);
+
+   // ABDADA : this position is marked while its moves are searched, at non-PV nodes other threads try it last (see below)
+   // marks are also used to count duplicated nodes (already being searched by another thread), with or without deferral
+   const bool abdada = DynamicConfig::threads > 1 && !subSearch && depth >= SearchConfig::abdadaMinDepth;
+   if (abdada && ABDADA::isSearched(pHash, 0, id())) stats.incr(Stats::sid_abdadaDuplicated);
+   const ABDADA::Guard abdadaGuard(abdada && pvsData.withoutSkipMove ? pHash : nullHash, depth, id());
+
+   // moves tried before the given one, for history malus (a deferred move was tried after all the others)
+   const auto forEachTriedBefore = [&](const Move m, auto&& f) { mp.forEachBefore(m, f); };
+
    const Move* it = nullptr;
-   //if(!pvsData.cutNode) ms.sort(moves); // we expect one of the first best move to fail high on cutNode
-   while ((it = ms.pickNextLazy(moves, offset/*, !pvsData.cutNode*/)) && !stopFlag) {
+   while ((it = mp.next()) && !stopFlag) {
 #else
    MoveSorter::scoreAndSort(moves);
+   const auto forEachTriedBefore = [&](const Move m, auto&& f) {
+      for (auto it2 = moves.begin(); it2 != moves.end() && !sameMove(*it2, m); ++it2) f(*it2);
+   };
    for (auto it = moves.begin(); it != moves.end() && !stopFlag; ++it) {
 #endif
 
@@ -1252,6 +1269,16 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
 
       // prefetch as soon as possible
       TT::prefetch(computeHash(child));
+
+#ifdef USE_PARTIAL_SORT
+      // the first move is always searched, the next ones are deferred if another thread is already on them
+      if constexpr(!pvnode) {
+         if (SearchConfig::doABDADA && abdada && pvsData.validMoveCount > 0 && ABDADA::isSearched(computeHash(child), depth - 1, id()) && mp.defer(*it)) {
+            stats.incr(Stats::sid_abdadaDeferred);
+            continue;
+         }
+      }
+#endif
       const Square to = Move2To(*it);
 #ifdef DEBUG_KING_CAP
       if (p.c == Co_White && to == p.king[Co_Black]) return matingScore(height - 1);
@@ -1268,18 +1295,16 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
       pvsData.isAdvancedPawnPush = PieceTools::getPieceType(p, Move2From(*it)) == P_wp && (SQRANK(to) > 5 || SQRANK(to) < 2);
       pvsData.earlyMove = pvsData.validMoveCount < (2 /*+2*pvsData.rootnode*/);
 
-      PVList childPV;
       // PVS
       if (pvsData.earlyMove || !SearchConfig::doPVS){
 #ifdef WITH_NNUE
-         initChildEvaluatorOnStack(p, child);
-         applyMoveNNUEUpdate(child, moveInfo);
+         deferChildEvaluatorOnStack(child, moveInfo.m);
 #endif
          stack[child.halfmoves].h = child.h;         
          // get depth of next search
          // Remember that if no tt hit, depth has been reduced already (by IIR)
          const auto [nextDepth, extension, reduction] = depthPolicy(p, depth, height, *it, pvsData, evalData, evalScore, extensions, false);
-         score = -pvs<pvnode>(-beta, -alpha, child, nextDepth, height + 1, childPV, seldepth, static_cast<DepthType>(extensions + extension), pvsData.isCheck, false);
+         score = -pvs<pvnode>(-beta, -alpha, child, nextDepth, height + 1, seldepth, static_cast<DepthType>(extensions + extension), pvsData.isCheck, false);
          ++pvsData.validNonPrunedCount;
       }
       else {
@@ -1377,15 +1402,13 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
 
          // PVS
 #ifdef WITH_NNUE
-         initChildEvaluatorOnStack(p, child);
-         applyMoveNNUEUpdate(child, moveInfo);
+         deferChildEvaluatorOnStack(child, moveInfo.m);
 #endif
          stack[child.halfmoves].h = child.h;         
-         score = -pvs<false>(-alpha - 1, -alpha, child, nextDepth, height + 1, childPV, seldepth, static_cast<DepthType>(extensions + extension), pvsData.isCheck, true);
+         score = -pvs<false>(-alpha - 1, -alpha, child, nextDepth, height + 1, seldepth, static_cast<DepthType>(extensions + extension), pvsData.isCheck, true);
          if (reduction > 0 && score > alpha) {
             stats.incr(Stats::sid_lmrFail);
-            childPV.clear();
-            score = -pvs<false>(-alpha - 1, -alpha, child, depth - 1 + extension, height + 1, childPV, seldepth, static_cast<DepthType>(extensions + extension), pvsData.isCheck, !pvsData.cutNode);
+            score = -pvs<false>(-alpha - 1, -alpha, child, depth - 1 + extension, height + 1, seldepth, static_cast<DepthType>(extensions + extension), pvsData.isCheck, !pvsData.cutNode);
 /*
             if (pvsData.isQuiet){
                if (score > alpha) historyT.update<1>(nextDepth, *it, p, pvsData.cmhPtr);
@@ -1401,9 +1424,8 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
          }
          if ( score > alpha && (pvsData.rootnode || score < beta)) {
             stats.incr(Stats::sid_pvsFail);
-            childPV.clear();
             // potential new pv node
-            score = -pvs<true>(-beta, -alpha, child, depth - 1 + extension, height + 1, childPV, seldepth, static_cast<DepthType>(extensions + extension), pvsData.isCheck, false);
+            score = -pvs<true>(-beta, -alpha, child, depth - 1 + extension, height + 1, seldepth, static_cast<DepthType>(extensions + extension), pvsData.isCheck, false);
          }
       }
 
@@ -1419,7 +1441,7 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
          pvsData.bestMoveIsCheck = pvsData.isCheck;
          //bestScoreUpdated = true;
          if (score > alpha) {
-            if constexpr(pvnode) updatePV(pv, bestMove, childPV);
+            if constexpr(pvnode) updatePV(height, bestMove);
             pvsData.alphaUpdated = true;
             alpha = score;
             hashBound = TT::B_exact;
@@ -1434,17 +1456,17 @@ ScoreType Searcher::pvs(ScoreType                    alpha,
                      // increase history of this move
                      updateTables(*this, p, bonusDepth, height, bestMove, TT::B_beta, pvsData.cmhPtr);
                      // reduce history of all previous
-                     for (auto it2 = moves.begin(); it2 != moves.end() && !sameMove(*it2, bestMove); ++it2) {
-                        if (Move2Type(*it2) == T_std)
-                           historyT.update<-1>(bonusDepth, *it2, p, pvsData.cmhPtr);
-                     }
+                     forEachTriedBefore(bestMove, [&](const Move m) {
+                        if (Move2Type(m) == T_std)
+                           historyT.update<-1>(bonusDepth, m, p, pvsData.cmhPtr);
+                     });
                   }
                   else if ( isCapture(bestMove)){ // capture history
                      historyT.updateCap<1>(bonusDepth, bestMove, p);
-                     for (auto it2 = moves.begin(); it2 != moves.end() && !sameMove(*it2, bestMove); ++it2) {
-                        if (isCapture(*it2))
-                           historyT.updateCap<-1>(bonusDepth, *it2, p);
-                     }
+                     forEachTriedBefore(bestMove, [&](const Move m) {
+                        if (isCapture(m))
+                           historyT.updateCap<-1>(bonusDepth, m, p);
+                     });
                   }
                }
                hashBound = TT::B_beta;
@@ -30,8 +30,7 @@ ScoreType Searcher::qsearchNoPruning(ScoreType alpha, ScoreType beta, const Posi
       if (!applyMove(p2, moveInfo, true)) continue;
       stack[p2.halfmoves].h = p2.h;
 #ifdef WITH_NNUE
-      initChildEvaluatorOnStack(p, p2);
-      applyMoveNNUEUpdate(p2, moveInfo);
+      deferChildEvaluatorOnStack(p2, moveInfo.m);
 #endif      
       PVList childPV;
       const ScoreType score = -qsearchNoPruning(-beta, -alpha, p2, height + 1, seldepth, pv ? &childPV : nullptr);
@@ -157,7 +156,7 @@ ScoreType Searcher::qsearch(ScoreType       alpha,
       else {
          // we tried everthing ... now this position must be evaluated
          stats.incr(Stats::sid_ttscmiss);
-         evalScore = eval(p, evalData, *this);
+         evalScore = cachedEval(p, pHash, evalData);
 #ifdef DEBUG_STATICEVAL
          checkEval(p,evalScore,*this,"from eval (qsearch)");
 #endif
@@ -172,12 +171,6 @@ ScoreType Searcher::qsearch(ScoreType       alpha,
    ScoreType& qsearchEval = evalScore;
 #endif
 
-   if (!isInCheck && !ttHit){
-      // Be carefull here, _data in Entry is always (INVALIDMOVE,B_none,-2) here, so that collisions are a lot more likely
-      // depth -2 is used to ensure this will never be used directly (only evaluation score is of interest here...)
-      TT::setEntry(*this, pHash, INVALIDMOVE, TT::createHashScore(staticScore, height), TT::createHashScore(staticScore, height), TT::B_none, -2, isMainThread());
-   }
-
    // early cut-off based on the (corrected) static score
    if (qsearchEval >= beta) return qsearchEval;
    else if (qsearchEval > alpha) alpha = qsearchEval;
@@ -207,8 +200,7 @@ ScoreType Searcher::qsearch(ScoreType       alpha,
       if (const MoveInfo moveInfo(p2,e.m); applyMove(p2, moveInfo, true)) {
          stack[p2.halfmoves].h = p2.h;
 #ifdef WITH_NNUE
-         initChildEvaluatorOnStack(p, p2);
-         applyMoveNNUEUpdate(p2, moveInfo);
+         deferChildEvaluatorOnStack(p2, moveInfo.m);
 #endif         
          ++validMoveCount;
          //stack[p2.halfmoves].p = p2; ///@todo another expensive copy !!!!
@@ -300,8 +292,7 @@ ScoreType Searcher::qsearch(ScoreType       alpha,
       TT::prefetch(computeHash(p2));
       ++validMoveCount;
 #ifdef WITH_NNUE
-      initChildEvaluatorOnStack(p, p2);
-      applyMoveNNUEUpdate(p2, moveInfo);
+      deferChildEvaluatorOnStack(p2, moveInfo.m);
 #endif      
       //stack[p2.halfmoves].p = p2;
       //stack[p2.halfmoves].h = p2.h;
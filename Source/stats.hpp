@@ -15,6 +15,13 @@ struct Stats {
       sid_ttInsert,
       sid_ttPawnhits,
       sid_ttPawnInsert,
+      sid_evalCacheHits,
+      sid_evalCacheMiss,
+      sid_nnueRefreshHits,
+      sid_nnueRefreshMiss,
+      sid_nnueUpdateAvoided,
+      sid_nnueFc0Inputs, // first inner layer inputs of evaluations using the sparse path
+      sid_nnueFc0Active, // and how many of them were not zero
       sid_ttschits,
       sid_ttscmiss,
       sid_ttAlphaCut,
@@ -133,6 +140,8 @@ struct Stats {
       sid_evalNNUE2Gp2,
       sid_evalNNUE2Gp3,
       sid_PVupdate,
+      sid_abdadaDuplicated,
+      sid_abdadaDeferred,
       sid_maxid
    };
 
@@ -143,6 +152,13 @@ struct Stats {
       "ttInsert",
       "ttPawnhits",
       "ttPawnInsert",
+      "evalCacheHits",
+      "evalCacheMiss",
+      "nnueRefreshHits",
+      "nnueRefreshMiss",
+      "nnueUpdateAvoided",
+      "nnueFc0Inputs",
+      "nnueFc0Active",
       "ttScHits",
       "ttScMiss",
       "ttAlphaCut",
@@ -260,14 +276,18 @@ struct Stats {
       "evalNNUE2Gp1",
       "evalNNUE2Gp2",
       "evalNNUE2Gp3",
-      "PVupdate"};
+      "PVupdate",
+      "abdadaDuplicated",
+      "abdadaDeferred"};
 
    array1d<Counter, sid_maxid> counters;
 
 #ifdef WITH_STATS
    FORCE_FINLINE void incr(StatId id) { ++counters[id]; }
+   FORCE_FINLINE void add(StatId id, Counter n) { counters[id] += n; }
 #else
    FORCE_FINLINE void incr(StatId) {}
+   FORCE_FINLINE void add(StatId, Counter) {}
 #endif
 
    void init() {
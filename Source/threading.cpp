@@ -1,9 +1,11 @@
 #include "threading.hpp"
 
+#include "abdada.hpp"
 #include "com.hpp"
 #include "distributed.h"
 #include "dynamicConfig.hpp"
 #include "logging.hpp"
+#include "numa.hpp"
 #include "searcher.hpp"
 
 namespace {
@@ -22,10 +24,23 @@ ThreadPool::~ThreadPool() {
 
 void ThreadPool::initPawnTables(){
    for (const auto& s : instance()) {
+      const Numa::NodeScope scope(cpuForThread((*s).id()));
       (*s).initPawnTable();
    }
 }
 
+void ThreadPool::initEvalCaches(){
+   for (const auto& s : instance()) {
+      const Numa::NodeScope scope(cpuForThread((*s).id()));
+      (*s).initEvalCache();
+   }
+}
+
+int ThreadPool::cpuForThread(const size_t k) {
+   if (DynamicConfig::threadBinding == "none" || k >= MAX_THREADS) return -1;
+   return Numa::cpuForThread(k, DynamicConfig::threadBinding == "compact");
+}
+
 void ThreadPool::setup() {
    assert(DynamicConfig::threads > 0);
    Logging::LogIt(Logging::logInfo) << "Using " << DynamicConfig::threads << " threads";
@@ -38,13 +53,35 @@ void ThreadPool::setup() {
       DynamicConfig::threads = maxThreads;
    }
 #endif
+   if (DynamicConfig::threadBinding != "none") {
+      const auto& nodes = Numa::topology();
+      Logging::LogIt(Logging::logInfo) << "Thread binding " << DynamicConfig::threadBinding << " on " << nodes.size() << " NUMA node(s)";
+      for (size_t node = 0; node < nodes.size(); ++node) {
+         std::stringstream str;
+         for (const int cpu : nodes[node]) str << " " << cpu;
+         Logging::LogIt(Logging::logInfo) << "Node " << node << " cpus" << (nodes[node].empty() ? " unknown" : str.str());
+      }
+      // cpu indices wrap when there are more threads than cpus (or than cpus of a node for spread binding)
+      std::set<int> usedCpus;
+      for (size_t k = 0; k < DynamicConfig::threads; ++k) usedCpus.insert(cpuForThread(k));
+      if (!usedCpus.contains(-1) && usedCpus.size() < DynamicConfig::threads)
+         Logging::LogIt(Logging::logWarn) << "Oversubscribing : " << DynamicConfig::threads << " threads pinned on " << usedCpus.size() << " cpus ("
+                                          << Numa::cpuCount() << " available), some threads will share a cpu";
+   }
    // init other threads (for main see below)
+   // each searcher and its tables are allocated and first-touched on the node of its thread
    while (size() < DynamicConfig::threads) {
+      const int cpu = cpuForThread(size());
+      if (DynamicConfig::threadBinding != "none")
+         Logging::LogIt(Logging::logInfo) << "Thread " << size() << (cpu < 0 ? " not pinned" : " on cpu " + std::to_string(cpu) + " (node " + std::to_string(Numa::nodeOfCpu(cpu)) + ")");
+      const Numa::NodeScope scope(cpu);
       push_back(std::unique_ptr<Searcher>(new Searcher(size())));
       back()->initPawnTable();
+      back()->initEvalCache();
       back()->clearGame();
    }
    Logging::LogIt(Logging::logInfo) << "Total size of Pawn TTs " << back()->ttSizePawn * DynamicConfig::threads * sizeof(Searcher::PawnEntry) / 1024 << "Kb";
+   Logging::LogIt(Logging::logInfo) << "Total size of eval caches " << back()->ttSizeEval * DynamicConfig::threads * sizeof(Searcher::EvalEntry) / 1024 << "Kb";
 }
 
 Searcher& ThreadPool::main() { return *(front()); }
@@ -87,13 +124,14 @@ void ThreadPool::startOthers() const {
 }
 
 void ThreadPool::clearGame() const {
-   TT::clearTT();
+   if (!TT::isPersistent()) TT::clearTT();
+   ABDADA::clear();
    for (const auto& s : *this) (*s).clearGame();
 }
 
 void ThreadPool::clearSearch() const {
 #ifdef REPRODUCTIBLE_RESULTS
-   TT::clearTT();
+   if (!TT::isPersistent()) TT::clearTT();
 #endif
    for (const auto& s : *this) (*s).clearSearch();
    Distributed::initStat();
@@ -107,6 +145,8 @@ void ThreadPool::stop() const {
 void ThreadPool::displayStats() const {
    if (DynamicConfig::minOutputLevel > Logging::logInfo) return;
    for (size_t k = 0; k < Stats::sid_maxid; ++k) { Logging::LogIt(Logging::logInfo) << Stats::Names[k] << " " << counter((Stats::StatId)k); }
+   if (const Counter inputs = counter(Stats::sid_nnueFc0Inputs); inputs > 0)
+      Logging::LogIt(Logging::logInfo) << "nnueFc0Sparsity " << 100. * (1. - static_cast<double>(counter(Stats::sid_nnueFc0Active)) / static_cast<double>(inputs)) << "%";
 }
 
 Counter ThreadPool::counter(Stats::StatId id, bool forceLocal) const {
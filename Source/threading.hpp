@@ -57,6 +57,10 @@ class ThreadPool : public std::vector<std::unique_ptr<Searcher>> {
    ThreadPool& operator=(const ThreadPool&&) = delete;
 
    static void initPawnTables();
+   static void initEvalCaches();
+
+   // cpu of the k-th search thread following DynamicConfig::threadBinding, -1 if not pinned
+   [[nodiscard]] static int cpuForThread(size_t k);
 
    [[nodiscard]] Searcher& main();
    void setup();
@@ -1,20 +1,22 @@
 #include "timers.hpp"
 
-#ifdef WITH_TIMER
-
-#include "logging.hpp"
-
-#ifdef _WIN32
+#if defined(_WIN32) && (defined(_M_X64) || defined(_M_IX86))
 #include <intrin.h>
-FORCE_FINLINE uint64_t rdtsc() { return __rdtsc(); }
-#else
+uint64_t rdtsc() { return __rdtsc(); }
+#elif defined(__x86_64__) || defined(__i386__)
 uint64_t rdtsc() {
    unsigned int lo, hi;
    __asm__ __volatile__("rdtsc" : "=a"(lo), "=d"(hi));
    return ((uint64_t)hi << 32) | lo;
 }
+#else
+uint64_t rdtsc() { return std::chrono::duration_cast<std::chrono::nanoseconds>(std::chrono::steady_clock::now().time_since_epoch()).count(); }
 #endif
 
+#ifdef WITH_TIMER
+
+#include "logging.hpp"
+
 namespace Timers {
 
 uint64_t rdtscCounter[TM_Max] = {0ull};
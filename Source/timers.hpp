@@ -6,8 +6,10 @@
  * A little instrumentation facility to study part of Minic speed
  */
 
-#ifdef WITH_TIMER
+// CPU time stamp counter (steady clock nanoseconds on non x86 targets)
 [[nodiscard]] uint64_t rdtsc();
+
+#ifdef WITH_TIMER
 #define START_TIMER uint64_t rdtscBegin = rdtsc();
 #define STOP_AND_SUM_TIMER(name)                            \
    Timers::rdtscCounter[TM_##name] += rdtsc() - rdtscBegin; \
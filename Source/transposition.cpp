@@ -5,62 +5,391 @@
 #include "logging.hpp"
 #include "moveApply.hpp"
 #include "movePseudoLegal.hpp"
+#include "numa.hpp"
 #include "position.hpp"
 #include "searcher.hpp"
 #include "tools.hpp"
 
+#ifdef __linux__
+#include <cerrno>
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#endif
+
 namespace {
 
-template<class T> struct DeleteAligned {
-   void operator()(T *ptr) const {
-      if (ptr) std_aligned_free(ptr);
+void detachShared(void * base, size_t size);
+
+// TT memory is coming either from the aligned allocator or from mmap (huge pages, file or shared memory)
+struct TableDeleter {
+   void * mappedBase = nullptr; // nullptr if aligned allocator was used
+   size_t mappedSize = 0;
+   bool   shared     = false;
+   void operator()(TT::Bucket *ptr) const {
+      if (!ptr) return;
+#ifdef __linux__
+      if (shared) {
+         detachShared(mappedBase, mappedSize);
+         return;
+      }
+      if (mappedBase) {
+         munmap(mappedBase, mappedSize);
+         return;
+      }
+#endif
+      std_aligned_free(ptr);
    }
 };
+using TablePtr = std::unique_ptr<TT::Bucket[], TableDeleter>;
 
-uint64_t ttSize = 0;
-std::unique_ptr<TT::Entry[], DeleteAligned<TT::Entry>> table(nullptr);
+uint64_t ttSize = 0; // number of buckets
+TablePtr table(nullptr);
+bool     numaClearing = false; // first-touch TT pages from each NUMA node
+bool     persistent   = false; // table is mapped from a TT file or shared with other processes
+std::atomic<GenerationType> localGeneration {0}; // TT::generation if the table is not shared
 
-} // namespace
-namespace TT {
+#ifdef __linux__
+constexpr size_t hugePageSize = 2ull * 1024ull * 1024ull;
+
+[[nodiscard]] std::string thpSetting() {
+   std::ifstream f("/sys/kernel/mm/transparent_hugepage/enabled");
+   std::string s;
+   std::getline(f, s);
+   return s.empty() ? "unknown" : s;
+}
+
+void * thpBase = nullptr; // madvised range, to check what the kernel really gave once pages are touched
+size_t thpSize = 0;
+
+// sum of AnonHugePages (in Kb) of the mappings overlapping [base, base + size), from /proc/self/smaps
+[[nodiscard]] size_t anonHugePagesKb(const void * base, const size_t size) {
+   const uintptr_t begin = reinterpret_cast<uintptr_t>(base);
+   const uintptr_t end   = begin + size;
+   std::ifstream f("/proc/self/smaps");
+   bool   inRange = false;
+   size_t kb      = 0;
+   for (std::string line; std::getline(f, line);) {
+      if (line.rfind("AnonHugePages:", 0) == 0) {
+         if (inRange) {
+            std::istringstream iss(line.substr(14));
+            size_t v = 0;
+            iss >> v;
+            kb += v;
+         }
+         continue;
+      }
+      // mapping header "begin-end perms ..."
+      std::istringstream iss(line);
+      uintptr_t b = 0, e = 0;
+      char      dash = 0;
+      if (iss >> std::hex >> b >> dash >> e && dash == '-') inRange = b < end && e > begin;
+   }
+   return kb;
+}
+#endif
+
+// persistent TT file header, buckets follow it and stay cache line aligned inside the mapping
+struct alignas(64) FileHeader {
+   static constexpr array1d<char, 8> expectedMagic   = {'M', 'i', 'n', 'i', 'c', 'T', 'T', '\0'};
+   static constexpr uint32_t         expectedVersion = 1;
+   array1d<char, 8> magic            = expectedMagic;
+   uint32_t         version          = expectedVersion;
+   uint32_t         entrySize        = sizeof(TT::Entry);
+   uint32_t         bucketSize       = sizeof(TT::Bucket);
+   uint32_t         entriesPerBucket = TT::Bucket::nbEntries;
+   uint64_t         nbBuckets        = 0;
+   uint64_t         netHash          = 0;
+   GenerationType   generation       = 0;
+};
+static_assert(sizeof(FileHeader) == 64, "TT file header must keep buckets aligned");
+
+// TT scores depend on the evaluation, so the net is part of the file identity
+[[nodiscard]] uint64_t currentNetHash() {
+#ifdef WITH_NNUE
+   if (DynamicConfig::useNNUE) return NNUEEvaluator::weights.hash;
+#endif
+   return 0;
+}
 
-GenerationType curGen = 0;
+// shared memory segment header, followed by the buckets
+// ready is set once the creator has written info, generation is shared so that aging and hashfull are the same in all processes
+struct alignas(64) SharedHeader {
+   FileHeader                  info;
+   std::atomic<uint32_t>       ready {0};
+   std::atomic<GenerationType> generation {0};
+};
+static_assert(std::atomic<uint32_t>::is_always_lock_free && std::atomic<GenerationType>::is_always_lock_free, "shared TT needs lock-free atomics");
+
+std::string sharedName;      // currently attached segment
+int         sharedFd   = -1; // kept open while attached, it holds this process lock on the segment
+
+#if defined(__linux__) && !defined(__ANDROID__)
+// Segment ownership is tracked with an open file description lock on the whole segment :
+// each attached process holds a read lock, the kernel releases it if the process dies.
+// A process that can take the write lock is thus alone : it creates or resets the segment when attaching
+// (a segment left by crashed processes is detected this way), or removes it when detaching.
+// Unlike flock, converting the lock (write to read after creation) is atomic.
+[[nodiscard]] bool lockSegment(const int fd, const short type, const bool wait) {
+   struct flock fl {};
+   fl.l_type   = type;
+   fl.l_whence = SEEK_SET; // l_start = l_len = 0 : the whole segment
+   return fcntl(fd, wait ? F_OFD_SETLKW : F_OFD_SETLK, &fl) == 0;
+}
+
+// the last process to detach removes the segment
+void detachShared(void * base, const size_t size) {
+   localGeneration.store(TT::generation->load(std::memory_order_relaxed), std::memory_order_relaxed);
+   TT::generation = &localGeneration;
+   munmap(base, size);
+   if (lockSegment(sharedFd, F_WRLCK, false)) {
+      shm_unlink(sharedName.c_str());
+      Logging::LogIt(Logging::logInfo) << "Shared TT segment " << sharedName << " removed";
+   }
+   close(sharedFd); // releases the lock
+   sharedFd = -1;
+}
+
+// attach to the named segment, or create and size it if no other process is using it
+// entries are validated with the same xor scheme as inside one process, so no lock is needed while searching
+[[nodiscard]] bool attachSharedTable(const size_t size, std::string & granted) {
+   const std::string name = DynamicConfig::ttSharedMemory.front() == '/' ? DynamicConfig::ttSharedMemory : "/" + DynamicConfig::ttSharedMemory;
+   for (int attempt = 0; attempt < 100; ++attempt) {
+      const int fd = shm_open(name.c_str(), O_RDWR | O_CREAT, 0600);
+      if (fd < 0) {
+         Logging::LogIt(Logging::logError) << "Cannot open shared TT segment " << name << " (" << std::strerror(errno) << ")";
+         return false;
+      }
+      const bool alone = lockSegment(fd, F_WRLCK, false);
+      // otherwise wait for a creator still writing the header or for a last process removing the segment
+      if (!alone && !lockSegment(fd, F_RDLCK, true)) {
+         Logging::LogIt(Logging::logError) << "Cannot lock shared TT segment " << name << " (" << std::strerror(errno) << ")";
+         close(fd);
+         return false;
+      }
+      struct stat st {};
+      if (fstat(fd, &st) != 0 || st.st_nlink == 0) { // removed by the last process while we were waiting, open it again
+         close(fd);
+         continue;
+      }
+      const size_t mappedSize = alone ? sizeof(SharedHeader) + size : static_cast<size_t>(st.st_size);
+      if (!alone && mappedSize < sizeof(SharedHeader)) { // its creator died before sizing it, retry so that the segment gets reset
+         close(fd);
+         std::this_thread::sleep_for(std::chrono::milliseconds(10));
+         continue;
+      }
+      if (alone) {
+         if (st.st_size != 0) Logging::LogIt(Logging::logWarn) << "Shared TT segment " << name << " was left by a crashed process, it is reset";
+         // truncating first zeroes the pages, which is an empty table
+         if (ftruncate(fd, 0) != 0 || ftruncate(fd, static_cast<off_t>(mappedSize)) != 0) {
+            Logging::LogIt(Logging::logError) << "Cannot size shared TT segment " << name << " (" << std::strerror(errno) << ")";
+            shm_unlink(name.c_str());
+            close(fd);
+            return false;
+         }
+      }
+      void * mem = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_SHARED, fd, 0);
+      if (mem == MAP_FAILED) {
+         Logging::LogIt(Logging::logError) << "Cannot map shared TT segment " << name;
+         if (alone) shm_unlink(name.c_str());
+         close(fd);
+         return false;
+      }
+      auto * header = static_cast<SharedHeader *>(mem);
+      if (alone) {
+         FileHeader info;
+         info.nbBuckets = size / sizeof(TT::Bucket);
+         info.netHash   = currentNetHash();
+         header->info   = info;
+         header->ready.store(1, std::memory_order_release);
+         DISCARD lockSegment(fd, F_RDLCK, false); // downgrade, other processes can now attach
+      }
+      else if (header->ready.load(std::memory_order_acquire) == 0) {
+         // its creator died before publishing the header, retry so that the segment gets reset
+         munmap(mem, mappedSize);
+         close(fd);
+         std::this_thread::sleep_for(std::chrono::milliseconds(10));
+         continue;
+      }
+      else {
+         const FileHeader expected;
+         std::string      error;
+         if (header->info.magic != expected.magic || header->info.version != expected.version) error = "not a Minic TT segment";
+         else if (header->info.entrySize != expected.entrySize || header->info.bucketSize != expected.bucketSize ||
+                  header->info.entriesPerBucket != expected.entriesPerBucket)
+            error = "incompatible entry layout";
+         else if (mappedSize != sizeof(SharedHeader) + header->info.nbBuckets * sizeof(TT::Bucket)) error = "wrong table size";
+         else if (header->info.netHash != currentNetHash()) error = "used with another net";
+         if (!error.empty()) {
+            munmap(mem, mappedSize);
+            close(fd);
+            Logging::LogIt(Logging::logError) << "Cannot attach shared TT segment " << name << ", " << error;
+            return false;
+         }
+      }
+      ttSize         = header->info.nbBuckets;
+      sharedName     = name;
+      sharedFd       = fd;
+      TT::generation = &header->generation;
+      table          = TablePtr(reinterpret_cast<TT::Bucket *>(static_cast<char *>(mem) + sizeof(SharedHeader)), TableDeleter{mem, mappedSize, true});
+      persistent     = true;
+      granted        = "shared memory segment " + name + (alone ? " (created)" : " (attached)");
+      return true;
+   }
+   Logging::LogIt(Logging::logError) << "Cannot attach shared TT segment " << name << ", it keeps being removed or reset";
+   return false;
+}
+#else
+void detachShared(void *, size_t) {}
+#endif
 
+// allocate TT memory following DynamicConfig::ttAllocation and return what was really granted
+[[nodiscard]] std::string allocateTable(const size_t size) {
+   table      = TablePtr(nullptr); // free previous table first
+   persistent = false;
 #ifdef __linux__
-#include <sys/mman.h>
+   thpBase = nullptr;
+   thpSize = 0;
+#endif
+   numaClearing = DynamicConfig::ttAllocation == "numa" && Numa::nodeCount() > 1;
+   if (!DynamicConfig::ttSharedMemory.empty()) {
+#if defined(__linux__) && !defined(__ANDROID__)
+      numaClearing = false;
+      if (std::string granted; attachSharedTable(size, granted)) return granted;
+#endif
+      Logging::LogIt(Logging::logWarn) << "Shared TT not available, using a private table";
+   }
+#ifdef __linux__
+   if (DynamicConfig::ttAllocation != "default") {
+      const size_t hugeSize = ((size + hugePageSize - 1) / hugePageSize) * hugePageSize;
+      // explicit huge pages first (only available if reserved using vm.nr_hugepages)
+      void * mem = mmap(nullptr, hugeSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS | MAP_HUGETLB, -1, 0);
+      if (mem != MAP_FAILED) {
+         table = TablePtr(static_cast<TT::Bucket *>(mem), TableDeleter{mem, hugeSize});
+         return "explicit huge pages (MAP_HUGETLB)";
+      }
+      // then transparent huge pages, over allocate in order to get a huge page aligned table
+      const size_t mappedSize = hugeSize + hugePageSize;
+      mem = mmap(nullptr, mappedSize, PROT_READ | PROT_WRITE, MAP_PRIVATE | MAP_ANONYMOUS, -1, 0);
+      if (mem != MAP_FAILED) {
+         void * aligned = reinterpret_cast<void *>((reinterpret_cast<uintptr_t>(mem) + hugePageSize - 1) & ~(hugePageSize - 1));
+         table = TablePtr(static_cast<TT::Bucket *>(aligned), TableDeleter{mem, mappedSize});
+#ifdef MADV_HUGEPAGE
+         if (madvise(aligned, hugeSize, MADV_HUGEPAGE) == 0) {
+            thpBase = aligned;
+            thpSize = hugeSize;
+            return "transparent huge pages requested (madvise, THP setting: " + thpSetting() + ")";
+         }
 #endif
+         return "standard pages (huge pages refused)";
+      }
+      Logging::LogIt(Logging::logWarn) << "Cannot mmap TT memory, using default allocator";
+   }
+#endif
+   table = TablePtr(static_cast<TT::Bucket *>(std_aligned_alloc(1024, size)));
+   return "default allocator";
+}
+
+[[nodiscard]] FORCE_FINLINE TT::Bucket & getBucket(const Hash h) { return table[h & (ttSize - 1)]; }
+
+[[nodiscard]] FORCE_FINLINE GenerationType entryGen(const TT::Entry & e) { return static_cast<GenerationType>((e.b & TT::B_gen) >> 5); }
+
+// generation distance to current one, 3 bits cyclic (see Bound::B_gen)
+[[nodiscard]] FORCE_FINLINE int relativeAge(const TT::Entry & e) { return (TT::curGen() - entryGen(e)) & 7; }
+
+[[nodiscard]] FORCE_FINLINE bool isKeyMatching(const TT::Entry & e, const MiniHash key) {
+   return e.h != nullHash && (e.h ^ e._data1 ^ e._data2) == key;
+}
+
+// store e (already xored) inside its bucket
+// - an entry for the same position is updated, keeping its move if the new one has none,
+//   but a deeper exact entry from this search is not overwritten by a shallow bound
+// - otherwise the least valuable entry is replaced, value is depth minus a penalty for older generations
+void store(const Hash h, TT::Entry e) {
+   TT::Bucket & bucket = getBucket(h);
+   const MiniHash key = Hash64to32(h);
+   TT::Entry * replace = &bucket.entries[0];
+   int replaceValue = std::numeric_limits<int>::max();
+   for (auto & cur : bucket.entries) {
+      if (isKeyMatching(cur, key)) {
+         if (!isValidMove(e.m) && isValidMove(cur.m)) {
+            e.h ^= e._data2;
+            e.m = cur.m;
+            e.h ^= e._data2;
+         }
+         if ((e.b & TT::B_exact) != TT::B_exact && (cur.b & TT::B_exact) == TT::B_exact && relativeAge(cur) == 0 && cur.d > e.d + 3) return;
+         cur = e;
+         return;
+      }
+      if (cur.h == nullHash) { // empty slot
+         replace = &cur;
+         replaceValue = std::numeric_limits<int>::min();
+         continue;
+      }
+      const int value = cur.d - 8 * relativeAge(cur);
+      if (value < replaceValue) {
+         replace = &cur;
+         replaceValue = value;
+      }
+   }
+   *replace = e;
+}
+
+} // namespace
+namespace TT {
+
+std::atomic<GenerationType>* generation = &localGeneration;
 
 void initTable() {
    Logging::LogIt(Logging::logInfo) << "Init TT";
-   Logging::LogIt(Logging::logInfo) << "Entry size " << sizeof(Entry);
-   ttSize = powerFloor((SIZE_MULTIPLIER * DynamicConfig::ttSizeMb) / sizeof(Entry));
+   if (!DynamicConfig::ttSharedMemory.empty() && !DynamicConfig::ttFile.empty())
+      Logging::LogIt(Logging::logWarn) << "TTFile " << DynamicConfig::ttFile << " is ignored while TTSharedMemory is set";
+   if (DynamicConfig::ttSharedMemory.empty() && !DynamicConfig::ttFile.empty() && loadTT(DynamicConfig::ttFile)) return;
+   Logging::LogIt(Logging::logInfo) << "Entry size " << sizeof(Entry) << ", bucket size " << sizeof(Bucket) << " (" << Bucket::nbEntries << " entries)";
+   ttSize = powerFloor((SIZE_MULTIPLIER * DynamicConfig::ttSizeMb) / sizeof(Bucket));
    assert(BB::countBit(ttSize) == 1); // a power of 2
-   table.reset((Entry *)std_aligned_alloc(1024, ttSize * sizeof(Entry)));
-   Logging::LogIt(Logging::logInfo) << "Size of TT " << ttSize * sizeof(Entry) / 1024 / 1024 << "Mb (" << ttSize << " entries)";
-   clearTT();
+   const std::string granted = allocateTable(ttSize * sizeof(Bucket));
+   Logging::LogIt(Logging::logInfo) << "Size of TT " << ttSize * sizeof(Bucket) / 1024 / 1024 << "Mb (" << ttSize << " buckets, " << ttSize * Bucket::nbEntries << " entries)";
+   Logging::LogIt(Logging::logInfo) << "TT allocation mode " << DynamicConfig::ttAllocation << ", granted: " << granted
+                                    << (numaClearing ? ", first-touch on " + std::to_string(Numa::nodeCount()) + " NUMA nodes" : "");
+   if (!persistent) clearTT();
+#ifdef __linux__
+   // huge pages are only given (or not) when memory is touched, so check after zeroing
+   if (thpBase) Logging::LogIt(Logging::logInfo) << "TT transparent huge pages granted: " << anonHugePagesKb(thpBase, thpSize) / 1024 << "Mb of " << thpSize / 1024 / 1024 << "Mb";
+#endif
 }
 
 void clearTT() {
-   TT::curGen = 0;
-   Logging::LogIt(Logging::logInfo) << "Now zeroing TT memory using " << DynamicConfig::threads << " threads";
-   auto worker = [&](size_t begin, size_t end) { std::fill(&table[0] + begin, &table[0] + end, Entry()); };
-   threadedWork(worker, DynamicConfig::threads, ttSize);
+   TT::generation->store(0, std::memory_order_relaxed);
+   const size_t nbNodes   = numaClearing ? Numa::nodeCount() : 1;
+   const size_t nbThreads = std::max(static_cast<size_t>(DynamicConfig::threads), nbNodes);
+   Logging::LogIt(Logging::logInfo) << "Now zeroing TT memory using " << nbThreads << " threads";
+   auto worker = [&](size_t begin, size_t end) {
+      // each contiguous chunk of the TT is first touched from its own node
+      if (nbNodes > 1) Numa::bindCurrentThreadToNode(begin * nbNodes / ttSize);
+      std::fill(&table[0] + begin, &table[0] + end, Bucket());
+   };
+   threadedWork(worker, nbThreads, ttSize);
    Logging::LogIt(Logging::logInfo) << "... done ";
 }
 
 int hashFull() {
+   // only entries from current search are counted
    unsigned int count = 0;
-   const unsigned int samples = 1023 * 64;
+   const unsigned int samples = 1023 * 64 / Bucket::nbEntries;
    for (unsigned int k = 0; k < samples; ++k)
-      if (table[(k * 67) % ttSize].h != nullHash) ++count;
-   return static_cast<int>((count * 1000) / samples);
+      for (const auto & e : table[(k * 67) % ttSize].entries)
+         if (e.h != nullHash && relativeAge(e) == 0) ++count;
+   return static_cast<int>((count * 1000) / (samples * Bucket::nbEntries));
 }
 
 void age() {
-   TT::curGen = static_cast<GenerationType>((TT::curGen + 1) % 8); // see Bound::B_gen
+   // only 3 bits are used (see Bound::B_gen) and 256 is a multiple of 8, so the counter can simply wrap
+   TT::generation->fetch_add(1, std::memory_order_relaxed);
 }
 
 void prefetch(Hash h) {
-   void *addr = (&table[h & (ttSize - 1)]);
+   void *addr = &getBucket(h);
 #if defined(__INTEL_COMPILER)
    __asm__("");
 #elif defined(_MSC_VER)
@@ -76,11 +405,20 @@ bool getEntry(Searcher &context, const Position &p, Hash h, DepthType d, Entry &
    assert(h != nullHash);
    assert((h & (ttSize - 1)) == (h % ttSize));
    if (DynamicConfig::disableTT) return false;
-   // update entry immediatly to avoid further race condition and invalidate it later if needed
-   e = table[h & (ttSize - 1)];
+   // copy entry immediatly to avoid further race condition and invalidate it later if needed
+   const Bucket & bucket = getBucket(h);
 #ifdef DEBUG_HASH_ENTRY
+   e = bucket.entries[0];
    e._data1 = randomInt<uint32_t, 666>(0, UINT32_MAX);
    e._data2 = randomInt<uint32_t, 666>(0, UINT32_MAX);
+#else
+   const MiniHash key = Hash64to32(h);
+   e.h = nullHash;
+   for (const auto & cur : bucket.entries) {
+      e = cur;
+      if (isKeyMatching(e, key)) break;
+      e.h = nullHash;
+   }
 #endif
    if (e.h == nullHash) return false; //early exit
    if (
@@ -103,7 +441,6 @@ bool getEntry(Searcher &context, const Position &p, Hash h, DepthType d, Entry &
    }
 }
 
-// always replace
 void setEntry(Searcher &context, Hash h, Move m, ScoreType s, ScoreType eval, Bound b, DepthType d, bool distribute) {
    assert(h != nullHash); // can really happen in fact ... but rarely
    if (DynamicConfig::disableTT) return;
@@ -111,12 +448,107 @@ void setEntry(Searcher &context, Hash h, Move m, ScoreType s, ScoreType eval, Bo
    e.h ^= e._data1;
    e.h ^= e._data2;
    context.stats.incr(Stats::sid_ttInsert);
-   table[h & (ttSize - 1)] = e; // always replace (favour leaf)
+   store(h, e);
    // only update buffer for other process on main thread
    if (distribute) Distributed::setEntry(h, e);
 }
 
-void _setEntry(Hash h, const Entry &e) { table[h & (ttSize - 1)] = e; }
+void _setEntry(Hash h, const Entry &e) { store(h, e); }
+
+bool saveTT(const std::string &path) {
+   if (path.empty()) {
+      Logging::LogIt(Logging::logError) << "No file given to save TT";
+      return false;
+   }
+   FileHeader header;
+   header.nbBuckets  = ttSize;
+   header.netHash    = currentNetHash();
+   header.generation = curGen();
+   // write to a temporary file first, the target may be the file currently mapped
+   const std::string tmpPath = path + ".tmp";
+   {
+      std::ofstream f(tmpPath, std::ios::binary | std::ios::trunc);
+      if (!f) {
+         Logging::LogIt(Logging::logError) << "Cannot open " << tmpPath << " to save TT";
+         return false;
+      }
+      f.write(reinterpret_cast<const char *>(&header), sizeof(FileHeader));
+      f.write(reinterpret_cast<const char *>(&table[0]), static_cast<std::streamsize>(ttSize * sizeof(Bucket)));
+      if (!f) {
+         Logging::LogIt(Logging::logError) << "Error while saving TT to " << tmpPath;
+         return false;
+      }
+   }
+   if (std::rename(tmpPath.c_str(), path.c_str()) != 0) {
+      Logging::LogIt(Logging::logError) << "Cannot rename " << tmpPath << " to " << path;
+      return false;
+   }
+   Logging::LogIt(Logging::logInfo) << "TT saved to " << path << " (" << ttSize * sizeof(Bucket) / 1024 / 1024 << "Mb)";
+   return true;
+}
+
+bool loadTT(const std::string &path) {
+#ifdef __linux__
+   const int fd = open(path.c_str(), O_RDONLY);
+   if (fd < 0) {
+      Logging::LogIt(Logging::logInfo) << "No TT file " << path << " to load yet";
+      return false;
+   }
+   struct stat st {};
+   if (fstat(fd, &st) != 0 || static_cast<size_t>(st.st_size) < sizeof(FileHeader)) {
+      close(fd);
+      Logging::LogIt(Logging::logError) << "TT file " << path << " is too small";
+      return false;
+   }
+   const size_t fileSize = static_cast<size_t>(st.st_size);
+   // private mapping, search writes are never flushed back to the file
+   void *mem = mmap(nullptr, fileSize, PROT_READ | PROT_WRITE, MAP_PRIVATE, fd, 0);
+   close(fd);
+   if (mem == MAP_FAILED) {
+      Logging::LogIt(Logging::logError) << "Cannot map TT file " << path;
+      return false;
+   }
+   const FileHeader &header = *static_cast<const FileHeader *>(mem);
+   const FileHeader  expected;
+   std::string       error;
+   if (header.magic != expected.magic) error = "not a Minic TT file";
+   else if (header.version != expected.version) error = "wrong file format version";
+   else if (header.entrySize != expected.entrySize || header.bucketSize != expected.bucketSize || header.entriesPerBucket != expected.entriesPerBucket)
+      error = "incompatible entry layout";
+   else if (header.nbBuckets == 0 || BB::countBit(header.nbBuckets) != 1 || fileSize != sizeof(FileHeader) + header.nbBuckets * sizeof(Bucket))
+      error = "wrong table size";
+   else if (header.netHash != currentNetHash())
+      error = "saved with another net";
+   if (!error.empty()) {
+      munmap(mem, fileSize);
+      Logging::LogIt(Logging::logError) << "Cannot load TT file " << path << ", " << error;
+      return false;
+   }
+   ttSize = header.nbBuckets;
+   table  = TablePtr(reinterpret_cast<Bucket *>(static_cast<char *>(mem) + sizeof(FileHeader)), TableDeleter{mem, fileSize});
+   // only once the previous table is released, it may be a shared segment holding the generation of other processes
+   generation->store(header.generation, std::memory_order_relaxed);
+   numaClearing = false;
+   persistent   = true;
+   Logging::LogIt(Logging::logInfo) << "TT mapped from " << path << ", size " << ttSize * sizeof(Bucket) / 1024 / 1024 << "Mb (" << ttSize << " buckets)";
+   return true;
+#else
+   Logging::LogIt(Logging::logError) << "Loading TT from file " << path << " is only supported on Linux";
+   return false;
+#endif
+}
+
+bool isPersistent() { return persistent; }
+
+void loadTTFile() {
+   if (DynamicConfig::ttFile.empty()) return;
+   // same precedence as in initTable, a shared table is kept
+   if (!DynamicConfig::ttSharedMemory.empty()) {
+      Logging::LogIt(Logging::logWarn) << "TTFile " << DynamicConfig::ttFile << " is ignored while TTSharedMemory is set";
+      return;
+   }
+   loadTT(DynamicConfig::ttFile);
+}
 
 void getPV(const Position &p, Searcher &context, PVList &pv) {
    TT::Entry e;
@@ -6,16 +6,19 @@ struct Position;
 struct Searcher;
 
 /*!
- * TT in Minic is a very classic 1 entry per bucket cache,
+ * TT in Minic is a classic bucket based cache, each bucket is a cache line holding a few entries.
  * It stores a 32 bits hash and thus move from TT must be validating before being used
  * An entry is storing both static and evaluation score
  * as well as move, bound and depth.
- * ///@todo test using aging !
+ * Replacement inside a bucket is using depth, bound and generation (aging).
  */
 namespace TT {
 
+// current generation, it lives in the segment header when the table is shared between processes (see TTSharedMemory)
+extern std::atomic<GenerationType>* generation;
+
 // curGen is coded inside Bound using only 3bits, shifted by 5 (224 = 0x111)
-extern GenerationType curGen;
+[[nodiscard]] FORCE_FINLINE GenerationType curGen() { return generation->load(std::memory_order_relaxed) & 7; }
 
 enum Bound : uint8_t {
    B_none          = 0,
@@ -42,7 +45,7 @@ enum Bound : uint8_t {
 struct Entry {
    Entry(): m(INVALIDMINIMOVE), h(nullHash), s(0), e(0), b(B_none), d(-2) {}
    Entry(Hash _h, Move _m, ScoreType _s, ScoreType _e, Bound _b, DepthType _d):
-       h(Hash64to32(_h)), m(Move2MiniMove(_m)), s(_s), e(_e), b(static_cast<TT::Bound>(_b | (curGen << 5))), d(_d) {}
+       h(Hash64to32(_h)), m(Move2MiniMove(_m)), s(_s), e(_e), b(static_cast<TT::Bound>(_b | (curGen() << 5))), d(_d) {}
    MiniHash h; //32
    union {
       MiniHash _data1; //32
@@ -67,6 +70,13 @@ struct Entry {
 #pragma GCC diagnostic pop
 #endif // defined(__GNUC__)
 
+// a bucket is exactly a cache line
+struct alignas(64) Bucket {
+   static constexpr int nbEntries = 64 / sizeof(Entry); // 5 entries of 12 bytes
+   array1d<Entry, nbEntries> entries;
+};
+static_assert(sizeof(Bucket) == 64, "TT bucket must fit a cache line");
+
 [[nodiscard]] ScoreType createHashScore(ScoreType score, DepthType height);
 
 [[nodiscard]] ScoreType adjustHashScore(ScoreType score, DepthType height);
@@ -91,4 +101,16 @@ void setEntry(Searcher& context, Hash h, Move m, ScoreType s, ScoreType eval, Bo
 
 void _setEntry(Hash h, const Entry& e);
 
+// persistent TT, the file is a small header followed by the raw buckets
+bool saveTT(const std::string& path);
+
+// map the file (copy-on-write), nothing is parsed
+bool loadTT(const std::string& path);
+
+// TTFile option callback
+void loadTTFile();
+
+// a TT mapped from file or shared with other processes is kept between games
+[[nodiscard]] bool isPersistent();
+
 } // namespace TT
@@ -262,6 +262,16 @@ void processCommand(const std::string & command) {
       iss >> type;
       Logging::LogIt(Logging::logGUI) << "info string " << uciCommand << " not implemented yet";
    }
+   else if (uciCommand == "savett") {
+      if (ThreadPool::instance().main().searching()) {
+         Logging::LogIt(Logging::logGUI) << "info string " << uciCommand << " received but search in progress ...";
+      }
+      else {
+         std::string path;
+         iss >> path;
+         TT::saveTT(path.empty() ? DynamicConfig::ttFile : path);
+      }
+   }
    else if (uciCommand == "print") { Logging::LogIt(Logging::logInfo) << ToString(COM::position); }
    else if (uciCommand == "d") { Logging::LogIt(Logging::logInfo) << GetFEN(COM::position); }
    else if (uciCommand == "quit") {
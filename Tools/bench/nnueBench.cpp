@@ -0,0 +1,217 @@
+// NNUE micro-benchmark : each part of the net evaluation is timed on its own
+// (incremental updates, full refresh, inner layers per bucket and input dequantization),
+// where -evalSpeed mixes them with HCE, material hash and evaluator reset.
+// Build it with the nnue_bench target of Tools/build/CMakeLists.txt, then for instance
+//    nnue_bench -NNUEFile net.bin [-benchFile positions.epd] [-benchLoops 20] [-json results.json]
+// Without -benchFile a few well-known positions are used, a bigger EPD file gives more realistic cache behaviour.
+
+#include "minic.hpp"
+
+#include "moveApply.hpp"
+#include "moveGen.hpp"
+#include "positionTools.hpp"
+
+#ifdef WITH_NNUE
+
+namespace {
+
+struct BenchResult {
+   std::string name;
+   uint64_t    ops;
+   double      nsPerOp;
+   double      cyclesPerOp;
+};
+
+// incremental update sample : the move is already applied to child, but not to its accumulators
+struct UpdateSample {
+   size_t   parent; // index of the parent position (and evaluator)
+   Position child;
+   MoveInfo moveInfo;
+};
+
+// keeps the compiler from removing the measured work
+volatile float sink = 0.f;
+
+template<typename F> [[nodiscard]] BenchResult measure(const std::string& name, const int loops, const size_t opsPerLoop, F&& f) {
+   f(); // warm up
+   const auto     start      = std::chrono::steady_clock::now();
+   const uint64_t startTicks = rdtsc();
+   for (int k = 0; k < loops; ++k) f();
+   const uint64_t ticks = rdtsc() - startTicks;
+   const double   ns    = std::chrono::duration<double, std::nano>(std::chrono::steady_clock::now() - start).count();
+   const uint64_t ops   = static_cast<uint64_t>(loops) * opsPerLoop;
+   if (ops == 0) return {name, 0, 0., 0.};
+   return {name, ops, ns / static_cast<double>(ops), static_cast<double>(ticks) / static_cast<double>(ops)};
+}
+
+void display(const std::vector<BenchResult>& results) {
+   std::cout << std::left  << std::setw(22) << "benchmark"
+             << std::right << std::setw(15) << "ops"
+             << std::right << std::setw(15) << "ns/op"
+             << std::right << std::setw(15) << "cycles/op"
+             << std::endl;
+   for (const auto& r : results) {
+      std::cout << std::left  << std::setw(22) << r.name
+                << std::right << std::setw(15) << r.ops
+                << std::right << std::setw(15) << std::fixed << std::setprecision(2) << r.nsPerOp
+                << std::right << std::setw(15) << std::fixed << std::setprecision(2) << r.cyclesPerOp
+                << std::endl;
+   }
+}
+
+[[nodiscard]] bool writeJSON(const std::string& fileName, const std::vector<BenchResult>& results, const size_t nbPositions, const int loops) {
+   std::ofstream out(fileName);
+   if (!out) {
+      Logging::LogIt(Logging::logError) << "Cannot open " << fileName;
+      return false;
+   }
+   out << "{\n";
+   out << "  \"version\": \"" << MinicVersion << "\",\n";
+   out << "  \"kernels\": \"" << ISA::nnueKernels() << "\",\n";
+   out << "  \"net\": \"" << std::hex << NNUEEvaluator::weights.hash << std::dec << "\",\n";
+   out << "  \"positions\": " << nbPositions << ",\n";
+   out << "  \"loops\": " << loops << ",\n";
+   out << "  \"results\": [\n";
+   for (size_t k = 0; k < results.size(); ++k) {
+      const auto& r = results[k];
+      out << "    {\"name\": \"" << r.name << "\", \"ops\": " << r.ops << std::fixed << std::setprecision(3)
+          << ", \"ns_per_op\": " << r.nsPerOp << ", \"cycles_per_op\": " << r.cyclesPerOp << "}" << (k + 1 < results.size() ? "," : "") << "\n";
+   }
+   out << "  ]\n";
+   out << "}\n";
+   return true;
+}
+
+[[nodiscard]] bool nnueBench() {
+   if (!DynamicConfig::useNNUE) {
+      Logging::LogIt(Logging::logError) << "No net loaded (see -NNUEFile)";
+      return false;
+   }
+   std::string fileName;
+   std::string jsonFile;
+   int         loops = 20;
+   DISCARD     Options::getOption<std::string>(fileName, "benchFile");
+   DISCARD     Options::getOption<std::string>(jsonFile, "json");
+   DISCARD     Options::getOption<int>(loops, "benchLoops");
+   loops = std::max(loops, 1);
+
+   std::vector<std::string> fens;
+   if (!fileName.empty()) {
+      if (!readEPDFile(fileName, fens)) return false;
+   }
+   else {
+      fens = {std::string(startPosition),
+              "r3k2r/p1ppqpb1/bn2pnp1/3PN3/1p2P3/2N2Q1p/PPPBBPPP/R3K2R w KQkq - 0 1",
+              "8/2p5/3p4/KP5r/1R3p1k/8/4P1P1/8 w - - 0 1",
+              "r3k2r/Pppp1ppp/1b3nbN/nP6/BBP1P3/q4N2/Pp1P2PP/R2Q1RK1 w kq - 0 1",
+              "rnbq1k1r/pp1Pbppp/2p5/8/2B5/8/PPP1NnPP/RNBQK2R w KQ - 1 8",
+              "r4rk1/1pp1qppp/p1np1n2/2b1p1B1/2B1P1b1/P1NP1N2/1PP1QPPP/R4RK1 w - - 0 10",
+              "2r3k1/1q1nbppp/r3p3/3pP3/pPpP4/P1Q2N2/2RN1PPP/2R4K b - - 0 23",
+              "8/8/4k3/8/2p5/8/B2K4/8 w - - 0 1"};
+   }
+   if (fens.empty()) {
+      Logging::LogIt(Logging::logError) << "No position read";
+      return false;
+   }
+
+   // positions and their evaluators shall not move, positions and samples keep pointers to them
+   std::vector<RootPosition>  positions;
+   std::vector<NNUEEvaluator> evaluators(fens.size());
+   positions.reserve(fens.size());
+   for (size_t k = 0; k < fens.size(); ++k) {
+      positions.emplace_back(fens[k], false);
+      positions.back().associateEvaluator(evaluators[k]);
+      positions.back().resetNNUEEvaluator(evaluators[k]);
+   }
+
+   // king moves other than castling are left out (they mostly refresh the accumulator, see full_refresh)
+   std::vector<UpdateSample> quiet, capture, castle;
+   NNUEEvaluator             scratch;
+   for (size_t k = 0; k < positions.size(); ++k) {
+      const Position& p = positions[k];
+      MoveList        moves;
+      MoveGen::generate<MoveGen::GP_all>(p, moves);
+      for (size_t i = 0; i < moves.size(); ++i) {
+         const Move&    m     = moves[i];
+         Position       child = p;
+         const MoveInfo moveInfo(child, m);
+         if (!applyMove(child, moveInfo, true)) continue;
+         child.associateEvaluator(scratch);
+         if (isCastling(moveInfo.type)) castle.push_back({k, child, moveInfo});
+         else if (Abs(moveInfo.fromP) == P_wk) continue;
+         else if (isCapture(moveInfo.type)) capture.push_back({k, child, moveInfo});
+         else quiet.push_back({k, child, moveInfo});
+      }
+   }
+
+   std::vector<BenchResult> results;
+
+   auto updates = [&](std::vector<UpdateSample>& samples) {
+      return [&samples, &positions, &scratch]() {
+         for (auto& s : samples) applyMoveNNUEUpdate(s.child, s.moveInfo, positions[s.parent]);
+         sink = sink + scratch.white.active().data[0];
+      };
+   };
+   results.push_back(measure("update_quiet", loops, quiet.size(), updates(quiet)));
+   results.push_back(measure("update_capture", loops, capture.size(), updates(capture)));
+   results.push_back(measure("update_castle", loops, castle.size(), updates(castle)));
+
+   results.push_back(measure("full_refresh", loops, positions.size(), [&]() {
+      for (const auto& p : positions) p.resetNNUEEvaluator(scratch);
+      sink = sink + scratch.black.active().data[0];
+   }));
+
+   for (int bucket = 0; bucket < decltype(NNUEEvaluator::weights)::nbuckets; ++bucket) {
+      results.push_back(measure("propagate_bucket" + std::to_string(bucket), loops, positions.size(), [&]() {
+         float sum = 0.f;
+         for (size_t k = 0; k < positions.size(); ++k) sum += evaluators[k].propagate(positions[k].c, bucket).evaluation;
+         sink = sink + sum;
+      }));
+   }
+
+#ifdef USE_SIMD_INTRIN
+   // both perspectives, as done before fc0
+   constexpr size_t N        = nnue::firstInnerLayerSize;
+   constexpr bool   Q        = NNUEWrapper::quantization;
+   constexpr float  deqScale = 1.f / nnue::Quantization<Q>::scale;
+   results.push_back(measure("dequantize", loops, positions.size(), [&]() {
+      alignas(NNUEALIGNMENT) float x0[2 * N];
+      for (const auto& e : evaluators) {
+         simdDequantizeActivate_i16_f32<N, Q>(x0, e.white.active().data, deqScale);
+         simdDequantizeActivate_i16_f32<N, Q>(x0 + N, e.black.active().data, deqScale);
+         sink = sink + x0[0];
+      }
+   }));
+   results.push_back(measure("activate_u8", loops, positions.size(), [&]() {
+      alignas(NNUEALIGNMENT) uint8_t x0[2 * N];
+      for (const auto& e : evaluators) {
+         simdActivateU8_i16<N>(x0, e.white.active().data);
+         simdActivateU8_i16<N>(x0 + N, e.black.active().data);
+         sink = sink + x0[0];
+      }
+   }));
+#endif
+
+   std::cout << "NNUE micro-benchmark, kernels " << ISA::nnueKernels() << ", " << positions.size() << " positions, " << loops << " loops" << std::endl;
+   display(results);
+   if (!jsonFile.empty()) return writeJSON(jsonFile, results, positions.size(), loops);
+   return true;
+}
+
+} // namespace
+
+int main(int argc, char** argv) {
+   init(argc, argv);
+   const bool ret = nnueBench();
+   finalize();
+   return ret ? EXIT_SUCCESS : EXIT_FAILURE;
+}
+
+#else
+
+int main(int, char**) {
+   std::cout << "This build has no NNUE support" << std::endl;
+   return EXIT_FAILURE;
+}
+
+#endif
@@ -41,6 +41,9 @@ else
       tname=$(echo $t | sed 's/-m//g' | sed 's/arch=//g' | sed 's/ /_/g')
       exe=${exe}_${tname}
    fi
+   if [ -n "$ISADISPATCH" ]; then
+      exe=${exe}_dispatch
+   fi
    exe=${buildDir}/${exe}
 fi
 
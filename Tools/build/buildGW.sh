@@ -20,6 +20,9 @@ if [ "$t" != "-march=native" ]; then
    tname=$(echo $t | sed 's/-m//g' | sed 's/arch=//g' | sed 's/ /_/g')
    exe=${exe}_${tname}
 fi
+if [ -n "$ISADISPATCH" ]; then
+   exe=${exe}_dispatch
+fi
 exe=${exe}.exe
 
 echo "Building $exe"
@@ -33,6 +33,17 @@ for m in -march=athlon64-sse3 -march=barcelona -march=bdver1 -march=znver1 -marc
 done
 export NOPROFILE
 
+# one fat binary for all x86-64-v2 CPUs and up, AVX2/AVX-512 NNUE kernels and PEXT (not on Zen 1/2)
+# are selected at startup (see ISA::init)
+export ISADISPATCH=1
+m=-march=x86-64-v2
+echo $dir/build.sh $e $v $m $n $d
+$dir/build.sh $e $v $m $n $d
+echo "=================================="
+echo $dir/buildGW.sh $e $v $m $n $d
+$dir/buildGW.sh $e $v $m $n $d
+unset ISADISPATCH
+
 # an old win32 build (super slow engine)
 echo $dir/buildGW32.sh $e $v "-march=pentium2" $n $d
 $dir/buildGW32.sh $e $v "-march=pentium2" $n $d
@@ -60,6 +71,8 @@ echo '-------'
 $buildDir/minic_${v}_linux_x64_sandybridge bench 16 -NNUEFile $net 2>&1 | grep NODES
 echo '-------'
 $buildDir/minic_${v}_linux_x64_skylake bench 16 -NNUEFile $net 2>&1 | grep NODES
+echo '-------'
+$buildDir/minic_${v}_linux_x64_x86-64-v2_dispatch bench 16 -NNUEFile $net 2>&1 | grep NODES
 
 echo '---------------------------------'
 